@@ -49,6 +49,8 @@
 
 // Currently happens when fopen() fails or when AnalyseAllPlaysBin()
 // get a different number of boards in its first two arguments.
+// Also from SidesParBinAll() and DealerParBinAll() for a NULL
+// pointer or a negative number of tables.
 #define RETURN_UNKNOWN_FAULT -1
 #define TEXT_UNKNOWN_FAULT "General error"
 
@@ -121,6 +123,7 @@
 // (a) Less than 0 or more than 52 cards supplied.
 // (b) Invalid suit or rank supplied.
 // (c) A played card is not held by the right player.
+// Also from SessionPlayCard() for a card that may not be played.
 #define RETURN_PLAY_FAULT -98
 #define TEXT_PLAY_FAULT "AnalysePlay input error"
 
@@ -157,6 +160,18 @@
 #define RETURN_CHUNK_SIZE -301
 #define TEXT_CHUNK_SIZE "Chunk size is less than 1"
 
+// SetEndgameDatabase()
+#define RETURN_ENDGAME_DB -401
+#define TEXT_ENDGAME_DB "Endgame database could not be loaded"
+
+// SessionPlayCard()
+#define RETURN_NO_SESSION -501
+#define TEXT_NO_SESSION "No game session on this thread"
+
+// SetDealFile(), ReadDealFile(), SolveDealFile()
+#define RETURN_DEAL_FILE -601
+#define TEXT_DEAL_FILE "Deal file could not be loaded or read"
+
 
 
 struct futureTricks
@@ -179,6 +194,22 @@ struct deal
 };
 
 
+// A deal in a canonical orientation, as made by CanonicalDeal().
+// Deals with the same canonical form have the same results, up to
+// the suit and seat mappings:
+// - The suit s of the original deal is suit suitOf[s] here. The
+//   trump suit becomes suit 0, and the other suits are ordered.
+// - Each seat h of the original deal is seat (h + rotation) & 3
+//   here, and rotation is 0 or 2.
+
+struct dealCanonical
+{
+  struct deal dl;
+  int suitOf[DDS_SUITS];
+  int rotation;
+};
+
+
 struct dealPBN
 {
   int trump;
@@ -293,6 +324,13 @@ struct parResultsMaster
   struct contractType contracts[10]; /* Par contracts */
 };
 
+struct parResultsGrid
+{
+  /* Indexed by vulnerability (0 None, 1 Both, 2 NS, 3 EW)
+     and then by dealer. */
+  struct parResultsMaster results[4][DDS_HANDS];
+};
+
 struct parTextResults
 {
   char parText[2][128]; /* Short text for par information, e.g.
@@ -339,6 +377,16 @@ struct solvedPlays
   struct solvedPlay solved[MAXNOOFBOARDS];
 };
 
+struct optimalLine
+{
+  // The line plays fut[n].suit[0] and rank[0] in position n. Each
+  // fut[n] is what SolveBoard() gives there with target -1 and
+  // solutions 2: the tricks for the side to play, and all cards
+  // that take them.
+  int number;
+  struct futureTricks fut[52];
+};
+
 struct DDSInfo
 {
   // Version 2.8.0 has 2, 8, 0 and a string of 2.8.0
@@ -377,6 +425,26 @@ struct DDSInfo
   char systemString[1024];
 };
 
+// 0 = unknown, 1 = too many nodes, 2 = new deal, 3 = new trump,
+// 4 = memory exhausted, 5 = free memory
+#define DDS_STATS_RESET_REASONS 6
+
+struct DDSStats
+{
+  // Transposition tables, summed over all threads.
+  long long ttLookups;
+  long long ttHits;
+  long long ttStores;
+  long long ttReclaims; // Blocks reused once the TT is full
+  long long ttResets[DDS_STATS_RESET_REASONS];
+
+  // Alpha-beta search, summed over all threads.
+  long long abNodes;
+  long long quickTricksCutoffs;
+  long long laterTricksCutoffs;
+  long long abRootSearches; // Null-window searches from the root
+};
+
 
 
 EXTERN_C DLLEXPORT void STDCALL SetMaxThreads(
@@ -391,6 +459,23 @@ EXTERN_C DLLEXPORT void STDCALL SetResources(
 
 EXTERN_C DLLEXPORT void STDCALL FreeMemory();
 
+// Loads an endgame database made by egdbgen, or unloads it if
+// fname is NULL or empty. The searches read the mapped file without
+// a lock, so this must only be called while no solver call is
+// active on any thread, and while no game session solves ahead
+// (SetSessionSpeculation). Otherwise a search reads unmapped memory.
+EXTERN_C DLLEXPORT int STDCALL SetEndgameDatabase(
+  const char * fname);
+
+// Maps a deal file made by dealconv, or unmaps it if fname is NULL
+// or empty, and gives the number of deals in it. The file holds
+// complete deals in 16-byte records; see src/DealFile.h. As with
+// SetEndgameDatabase, this must only be called while no
+// ReadDealFile() or SolveDealFile() call is active on any thread.
+EXTERN_C DLLEXPORT int STDCALL SetDealFile(
+  const char * fname,
+  int * numberp);
+
 EXTERN_C DLLEXPORT int STDCALL SolveBoard(
   struct deal dl,
   int target,
@@ -407,6 +492,50 @@ EXTERN_C DLLEXPORT int STDCALL SolveBoardPBN(
   struct futureTricks * futp,
   int thrId);
 
+// A game session follows a deal card by card on thread thrId and
+// keeps the search state from one card to the next. Each call
+// gives what SolveBoard() gives with target -1 and solutions 1
+// for the new position. Use one thread index per game. Any other
+// solve on the thread in between costs a fresh setup, not an error.
+EXTERN_C DLLEXPORT int STDCALL StartSession(
+  struct deal dl,
+  int thrId,
+  struct futureTricks * futp);
+
+EXTERN_C DLLEXPORT int STDCALL StartSessionPBN(
+  struct dealPBN dlPBN,
+  int thrId,
+  struct futureTricks * futp);
+
+// After the last card, futp->cards is 0 and the session ends.
+EXTERN_C DLLEXPORT int STDCALL SessionPlayCard(
+  int suit,
+  int rank,
+  int thrId,
+  struct futureTricks * futp);
+
+// Solves the positions after up to cards likely next cards in the
+// background while the client waits for the next card. A card solved
+// ahead is answered at once. This needs the memory of one more
+// thread, which 0 gives back again, once a position that is being
+// solved is done. The setting stays with the thread index.
+EXTERN_C DLLEXPORT int STDCALL SetSessionSpeculation(
+  int cards,
+  int thrId);
+
+// Plays a double dummy optimal line from dl to the end on thread
+// thrId, solving each position as a game session would. This ends
+// a session on the thread.
+EXTERN_C DLLEXPORT int STDCALL GetOptimalLine(
+  struct deal dl,
+  int thrId,
+  struct optimalLine * linep);
+
+EXTERN_C DLLEXPORT int STDCALL GetOptimalLinePBN(
+  struct dealPBN dlPBN,
+  int thrId,
+  struct optimalLine * linep);
+
 EXTERN_C DLLEXPORT int STDCALL CalcDDtable(
   struct ddTableDeal tableDeal,
   struct ddTableResults * tablep);
@@ -429,6 +558,18 @@ EXTERN_C DLLEXPORT int STDCALL CalcAllTablesPBN(
   struct ddTablesRes * resp,
   struct allParResults * presp);
 
+// As CalcAllTables() with all strains, but with the dealer par
+// for every vulnerability and dealer. gridp gets one grid per table.
+EXTERN_C DLLEXPORT int STDCALL CalcAllTablesGrid(
+  struct ddTableDeals * dealsp,
+  struct ddTablesRes * resp,
+  struct parResultsGrid * gridp);
+
+EXTERN_C DLLEXPORT int STDCALL CalcAllTablesGridPBN(
+  struct ddTableDealsPBN * dealsp,
+  struct ddTablesRes * resp,
+  struct parResultsGrid * gridp);
+
 EXTERN_C DLLEXPORT int STDCALL SolveAllBoards(
   struct boardsPBN * bop,
   struct solvedBoards * solvedp);
@@ -437,6 +578,22 @@ EXTERN_C DLLEXPORT int STDCALL SolveAllBoardsBin(
   struct boards * bop,
   struct solvedBoards * solvedp);
 
+// Deals first .. first+number-1 of the deal file, at most
+// MAXNOOFBOARDS of them. dealerp and vulnerablep may be NULL.
+// A record with a field out of range gives RETURN_DEAL_FILE.
+EXTERN_C DLLEXPORT int STDCALL ReadDealFile(
+  int first,
+  int number,
+  struct boards * bop,
+  int * dealerp,
+  int * vulnerablep);
+
+// ReadDealFile() followed by SolveAllBoardsBin().
+EXTERN_C DLLEXPORT int STDCALL SolveDealFile(
+  int first,
+  int number,
+  struct solvedBoards * solvedp);
+
 EXTERN_C DLLDEPRECATED_EXPORT int STDCALL SolveAllChunks(
   struct boardsPBN * bop,
   struct solvedBoards * solvedp,
@@ -491,6 +648,45 @@ EXTERN_C DLLEXPORT int STDCALL SidesParBin(
   struct parResultsMaster sidesRes[2],
   int vulnerable);
 
+// SidesParBin() and DealerParBin() for number tables on all threads.
+// SidesParBinAll() gives two results per table. Any text is left to
+// ConvertToSidesTextFormat() and ConvertToDealerTextFormat().
+EXTERN_C DLLEXPORT int STDCALL SidesParBinAll(
+  struct ddTableResults * tablep,
+  int * vulnerablep,
+  int number,
+  struct parResultsMaster * presp);
+
+EXTERN_C DLLEXPORT int STDCALL DealerParBinAll(
+  struct ddTableResults * tablep,
+  int * dealerp,
+  int * vulnerablep,
+  int number,
+  struct parResultsMaster * presp);
+
+// DealerParBin() for all 16 combinations of vulnerability and
+// dealer at once.
+EXTERN_C DLLEXPORT int STDCALL DealerParBinGrid(
+  struct ddTableResults * tablep,
+  struct parResultsGrid * presp);
+
+// ConvertFromPBNAll() and ConvertTablesFromPBNAll() convert number
+// PBN deals, on all threads for large batches. resp gets a code per
+// deal: RETURN_NO_FAULT, or RETURN_PBN_FAULT for a malformed deal,
+// RETURN_TOO_MANY_CARDS or RETURN_DUPLICATE_CARDS. They return
+// RETURN_PBN_FAULT if any deal fails.
+EXTERN_C DLLEXPORT int STDCALL ConvertFromPBNAll(
+  struct dealPBN * dealsp,
+  int number,
+  struct deal * dlp,
+  int * resp);
+
+EXTERN_C DLLEXPORT int STDCALL ConvertTablesFromPBNAll(
+  struct ddTableDealPBN * dealsp,
+  int number,
+  struct ddTableDeal * dlp,
+  int * resp);
+
 EXTERN_C DLLEXPORT int STDCALL ConvertToDealerTextFormat(
   struct parResultsMaster * pres,
   char * resp);
@@ -511,6 +707,16 @@ EXTERN_C DLLEXPORT int STDCALL AnalysePlayPBN(
   struct solvedPlay * solvedp,
   int thrId);
 
+EXTERN_C DLLEXPORT int STDCALL AnalysePlayBinParallel(
+  struct deal dl,
+  struct playTraceBin play,
+  struct solvedPlay * solvedp);
+
+EXTERN_C DLLEXPORT int STDCALL AnalysePlayPBNParallel(
+  struct dealPBN dlPBN,
+  struct playTracePBN playPBN,
+  struct solvedPlay * solvedp);
+
 EXTERN_C DLLEXPORT int STDCALL AnalyseAllPlaysBin(
   struct boards * bop,
   struct playTracesBin * plp,
@@ -523,9 +729,19 @@ EXTERN_C DLLEXPORT int STDCALL AnalyseAllPlaysPBN(
   struct solvedPlays * solvedp,
   int chunkSize);
 
+EXTERN_C DLLEXPORT int STDCALL CanonicalDeal(
+  struct deal dl,
+  struct dealCanonical * canonp);
+
 EXTERN_C DLLEXPORT void STDCALL GetDDSInfo(
   struct DDSInfo * info);
 
+// The counters are not synchronized, so call these between batches.
+EXTERN_C DLLEXPORT void STDCALL GetDDSStats(
+  struct DDSStats * stats);
+
+EXTERN_C DLLEXPORT void STDCALL ResetDDSStats();
+
 EXTERN_C DLLEXPORT void STDCALL ErrorMessage(
   int code,
   char line[80]);
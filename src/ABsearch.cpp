@@ -10,17 +10,42 @@
 #include <iostream>
 #include <sstream>
 #include <assert.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
 
 #include "TransTable.h"
 #include "Moves.h"
 #include "QuickTricks.h"
 #include "LaterTricks.h"
+#include "EndgameDB.h"
 #include "ABsearch.h"
 #include "ABstats.h"
 #include "TimerList.h"
 #include "dump.h"
 #include "debug.h"
 
+extern EndgameDB endgameDB;
+
+
+inline void FlipCard(
+  unsigned short words[DDS_SUITS],
+  const unsigned long long card);
+
+int TopRank(const unsigned bits);
+
+void SetHighCard(
+  pos const * posPoint,
+  const int suit,
+  const unsigned bits,
+  highCardType& hc);
+
+void UpdateWinners(
+  pos * posPoint,
+  const int suit,
+  WinnersType * wp);
 
 void Make3Simple(
   pos * posPoint,
@@ -59,6 +84,7 @@ void Undo3(
 const int handDelta[DDS_SUITS] = { 256, 16, 1, 0 };
 
 
+template <class Strain>
 bool ABsearch(
   pos * posPoint,
   const int target,
@@ -76,6 +102,7 @@ bool ABsearch(
   bool success = (thrp->nodeTypeStore[hand] == MAXNODE ? true : false);
   bool value = ! success;
 
+  thrp->searchStats.nodes++;
 #ifdef DDS_TOP_LEVEL
   thrp->nodes++;
 #endif
@@ -113,7 +140,7 @@ bool ABsearch(
     Make0(posPoint, depth, mply);
 
     TIMER_START(TIMER_NO_AB, depth - 1);
-    value = ABsearch1(posPoint, target, depth - 1, thrp);
+    value = ABsearch1<Strain>(posPoint, target, depth - 1, thrp);
     TIMER_END(TIMER_NO_AB, depth - 1);
 
     TIMER_START(TIMER_NO_UNDO, depth);
@@ -151,6 +178,7 @@ ABexit:
 }
 
 
+template <class Strain>
 bool ABsearch0(
   pos * posPoint,
   const int target,
@@ -167,6 +195,7 @@ bool ABsearch0(
   int hand = posPoint->first[depth];
   int tricks = depth >> 2;
 
+  thrp->searchStats.nodes++;
 #ifdef DDS_TOP_LEVEL
   thrp->nodes++;
 #endif
@@ -230,7 +259,7 @@ bool ABsearch0(
   else if (depth == 0) /* Maximum depth? */
   {
     TIMER_START(TIMER_NO_EVALUATE, depth);
-    evalType evalData = Evaluate(posPoint, trump, thrp);
+    evalType evalData = Evaluate<Strain>(posPoint, trump, thrp);
     TIMER_END(TIMER_NO_EVALUATE, depth);
 
     bool value = (evalData.tricks >= target ? true : false);
@@ -242,9 +271,15 @@ bool ABsearch0(
     return value;
   }
 
+  // The TT lookup below comes after QuickTricks and LaterTricks,
+  // which is enough time to get the memory it needs into cache.
+  if (depth < 20)
+    thrp->transTable->Prefetch(tricks, hand, posPoint->aggr,
+      posPoint->handDist);
+
   bool res;
   TIMER_START(TIMER_NO_QT, depth);
-  int qtricks = QuickTricks(* posPoint, hand, depth, target,
+  int qtricks = QuickTricks<Strain>(* posPoint, hand, depth, target,
                             trump, res, * thrp);
   TIMER_END(TIMER_NO_QT, depth);
 
@@ -252,17 +287,20 @@ bool ABsearch0(
   {
     if (res)
     {
+      thrp->searchStats.quickTricksCutoffs++;
       AB_COUNT(AB_QUICKTRICKS, 1, depth);
       return (qtricks == 0 ? false : true);
     }
 
     TIMER_START(TIMER_NO_LT, depth);
-    res = LaterTricksMIN(* posPoint, hand, depth, target, trump, * thrp);
+    res = LaterTricksMIN<Strain>(* posPoint, hand, depth, target,
+      trump, * thrp);
     TIMER_END(TIMER_NO_LT, depth);
 
     if (! res)
     {
       // Is 1 right here?!
+      thrp->searchStats.laterTricksCutoffs++;
       AB_COUNT(AB_LATERTRICKS, true, depth);
       return false;
     }
@@ -271,16 +309,19 @@ bool ABsearch0(
   {
     if (res)
     {
+      thrp->searchStats.quickTricksCutoffs++;
       AB_COUNT(AB_QUICKTRICKS, false, depth);
       return (qtricks == 0 ? true : false);
     }
 
     TIMER_START(TIMER_NO_LT, depth);
-    res = LaterTricksMAX(* posPoint, hand, depth, target, trump, * thrp);
+    res = LaterTricksMAX<Strain>(* posPoint, hand, depth, target,
+      trump, * thrp);
     TIMER_END(TIMER_NO_LT, depth);
 
     if (res)
     {
+      thrp->searchStats.laterTricksCutoffs++;
       AB_COUNT(AB_LATERTRICKS, false, depth);
       return true;
     }
@@ -329,6 +370,20 @@ bool ABsearch0(
     }
   }
 
+  // The root is left to the search, as it has to come up with a move.
+  if (tricks < endgameDB.Tricks() && depth != thrp->iniDepth)
+  {
+    // What the side on lead needs for its side of the target.
+    const bool maxLead = (thrp->nodeTypeStore[hand] == MAXNODE);
+    const int need = (maxLead ? target - posPoint->tricksMAX :
+      tricks + 2 - target + posPoint->tricksMAX);
+
+    const int leaderTricks = endgameDB.Probe(posPoint->rankInSuit,
+      hand, trump, need, posPoint->winRanks[depth]);
+    if (leaderTricks >= 0)
+      return ((leaderTricks >= need) == maxLead);
+  }
+
   bool success = (thrp->nodeTypeStore[hand] == MAXNODE ? true : false);
   bool value = ! success;
 
@@ -364,7 +419,7 @@ bool ABsearch0(
     Make0(posPoint, depth, mply);
 
     TIMER_START(TIMER_NO_AB, depth - 1);
-    value = ABsearch1(posPoint, target, depth - 1, thrp);
+    value = ABsearch1<Strain>(posPoint, target, depth - 1, thrp);
     TIMER_END(TIMER_NO_AB, depth - 1);
 
     TIMER_START(TIMER_NO_UNDO, depth);
@@ -451,6 +506,7 @@ ABexit:
 }
 
 
+template <class Strain>
 bool ABsearch1(
   pos * posPoint,
   const int target,
@@ -463,12 +519,13 @@ bool ABsearch1(
   bool value = ! success;
   int tricks = (depth + 3) >> 2;
 
+  thrp->searchStats.nodes++;
 #ifdef DDS_TOP_LEVEL
   thrp->nodes++;
 #endif
 
   TIMER_START(TIMER_NO_QT, depth);
-  int res = QuickTricksSecondHand(* posPoint, hand, depth, target,
+  int res = QuickTricksSecondHand<Strain>(* posPoint, hand, depth, target,
      trump, * thrp);
   TIMER_END(TIMER_NO_QT, depth);
   if (res) 
@@ -506,7 +563,7 @@ bool ABsearch1(
     Make1(posPoint, depth, mply);
 
     TIMER_START(TIMER_NO_AB, depth - 1);
-    value = ABsearch2(posPoint, target, depth - 1, thrp);
+    value = ABsearch2<Strain>(posPoint, target, depth - 1, thrp);
     TIMER_END(TIMER_NO_AB, depth - 1);
 
     TIMER_START(TIMER_NO_UNDO, depth);
@@ -540,6 +597,7 @@ ABexit:
 }
 
 
+template <class Strain>
 bool ABsearch2(
   pos * posPoint,
   const int target,
@@ -551,6 +609,7 @@ bool ABsearch2(
   bool value = ! success;
   int tricks = (depth + 3) >> 2;
 
+  thrp->searchStats.nodes++;
 #ifdef DDS_TOP_LEVEL
   thrp->nodes++;
 #endif
@@ -585,7 +644,7 @@ bool ABsearch2(
     TIMER_END(TIMER_NO_MAKE, depth);
 
     TIMER_START(TIMER_NO_AB, depth - 1);
-    value = ABsearch3(posPoint, target, depth - 1, thrp);
+    value = ABsearch3<Strain>(posPoint, target, depth - 1, thrp);
     TIMER_END(TIMER_NO_AB, depth - 1);
 
     TIMER_START(TIMER_NO_UNDO, depth);
@@ -620,6 +679,7 @@ ABexit:
 }
 
 
+template <class Strain>
 bool ABsearch3(
   pos * posPoint,
   const int target,
@@ -634,6 +694,7 @@ bool ABsearch3(
   bool success = (thrp->nodeTypeStore[hand] == MAXNODE ? true : false);
   bool value = ! success;
 
+  thrp->searchStats.nodes++;
 #ifdef DDS_TOP_LEVEL
   thrp->nodes++;
 #endif
@@ -660,12 +721,16 @@ bool ABsearch3(
 #ifdef DDS_AB_STATS
     thrp->ABStats.IncrNode(depth);
 #endif
-    TIMER_END(TIMER_NO_MAKE, depth);
 
     if (mply == NULL)
+    {
+      TIMER_END(TIMER_NO_MAKE, depth);
       break;
+    }
 
+    // Make3 does the trick-boundary bookkeeping, so it is timed too.
     Make3(posPoint, makeWinRank, depth, mply, thrp);
+    TIMER_END(TIMER_NO_MAKE, depth);
 
     thrp->trickNodes++; // As handRelFirst == 0
 
@@ -673,7 +738,7 @@ bool ABsearch3(
       posPoint->tricksMAX++;
 
     TIMER_START(TIMER_NO_AB, depth - 1);
-    value = ABsearch0(posPoint, target, depth - 1, thrp);
+    value = ABsearch0<Strain>(posPoint, target, depth - 1, thrp);
     TIMER_END(TIMER_NO_AB, depth - 1);
 
     TIMER_START(TIMER_NO_UNDO, depth);
@@ -723,8 +788,8 @@ void Make0(
   posPoint->first[depth - 1] = h;
   posPoint->move[depth] = * mply;
 
-  posPoint->rankInSuit[h][s] &= (~bitMapRank[r]);
-  posPoint->aggr[s] ^= bitMapRank[r];
+  FlipCard(posPoint->rankInSuit[h], bitMapCard[s][r]);
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] -= handDelta[s];
   posPoint->length[h][s]--;
 }
@@ -743,8 +808,8 @@ void Make1(
   int s = mply->suit;
   int r = mply->rank;
 
-  posPoint->rankInSuit[h][s] &= (~bitMapRank[r]);
-  posPoint->aggr[s] ^= bitMapRank[r];
+  FlipCard(posPoint->rankInSuit[h], bitMapCard[s][r]);
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] -= handDelta[s];
   posPoint->length[h][s]--;
 }
@@ -763,8 +828,8 @@ void Make2(
   int s = mply->suit;
   int r = mply->rank;
 
-  posPoint->rankInSuit[h][s] &= (~bitMapRank[r]);
-  posPoint->aggr[s] ^= bitMapRank[r];
+  FlipCard(posPoint->rankInSuit[h], bitMapCard[s][r]);
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] -= handDelta[s];
   posPoint->length[h][s]--;
 }
@@ -801,8 +866,8 @@ void Make3(
 
   int r = mply->rank;
   int s = mply->suit;
-  posPoint->rankInSuit[h][s] &= (~bitMapRank[r]);
-  posPoint->aggr[s] ^= bitMapRank[r];
+  FlipCard(posPoint->rankInSuit[h], bitMapCard[s][r]);
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] -= handDelta[s];
   posPoint->length[h][s]--;
 
@@ -813,24 +878,102 @@ void Make3(
   for (int st = 0; st < 4; st++)
   {
     if (data.playCount[st])
-    {
-      int n = wp->number;
-      wp->winner[n].suit = st;
-      wp->winner[n].winnerRank = posPoint->winner[st].rank;
-      wp->winner[n].winnerHand = posPoint->winner[st].hand;
-      wp->winner[n].secondRank = posPoint->secondBest[st].rank;
-      wp->winner[n].secondHand = posPoint->secondBest[st].hand;
-      wp->number++;
+      UpdateWinners(posPoint, st, wp);
+  }
+}
+
 
-      int aggr = posPoint->aggr[st];
+inline void FlipCard(
+  unsigned short words[DDS_SUITS],
+  const unsigned long long card)
+{
+  // The four suit words as one 64-bit bitboard. ISO C++ only lets
+  // us look at them that way through memcpy, which compiles to a
+  // single load, XOR and store.
+  unsigned long long bits;
+  memcpy(&bits, words, sizeof(bits));
+  bits ^= card;
+  memcpy(words, &bits, sizeof(bits));
+}
 
-      posPoint->winner[st].rank = thrp->rel[aggr].absRank[1][st].rank;
-      posPoint->winner[st].hand = thrp->rel[aggr].absRank[1][st].hand;
-      posPoint->secondBest[st].rank = thrp->rel[aggr].absRank[2][st].rank;
-      posPoint->secondBest[st].hand = thrp->rel[aggr].absRank[2][st].hand;
 
-    }
+int TopRank(const unsigned bits)
+{
+  // Absolute rank (2 .. 14) of the highest card in a non-empty suit.
+#if defined(__GNUC__) || defined(__clang__)
+  return 33 - __builtin_clz(bits);
+#elif defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse(&index, bits);
+  return static_cast<int>(index) + 2;
+#else
+  return highestRank[bits];
+#endif
+}
+
+
+void SetHighCard(
+  pos const * posPoint,
+  const int suit,
+  const unsigned bits,
+  highCardType& hc)
+{
+  // The highest of the given cards of the suit and its hand.
+  if (bits == 0)
+  {
+    hc.rank = 0;
+    hc.hand = -1;
+    return;
   }
+
+  const int r = TopRank(bits);
+  const unsigned short card = bitMapRank[r];
+
+  int h = 0;
+  while ((posPoint->rankInSuit[h][suit] & card) == 0)
+    h++;
+
+  hc.rank = r;
+  hc.hand = h;
+}
+
+
+void UpdateWinners(
+  pos * posPoint,
+  const int suit,
+  WinnersType * wp)
+{
+  // The top two cards left in the suit and the hands holding
+  // them, after cards of the suit were played to the trick.
+  // Cards only ever leave, so the top two stay put unless one
+  // of them was played. Otherwise at most the cards below the
+  // one that is left are looked at. Only the suits that
+  // change are recorded for Undo0.
+
+  const unsigned aggr = posPoint->aggr[suit];
+  highCardType& winner = posPoint->winner[suit];
+  highCardType& second = posPoint->secondBest[suit];
+
+  const bool winnerLeft = ((aggr & bitMapRank[winner.rank]) != 0);
+  const bool secondLeft = ((aggr & bitMapRank[second.rank]) != 0);
+
+  if (winnerLeft && (secondLeft || second.rank == 0))
+    return;
+
+  WinnerEntryType& entry = wp->winner[wp->number++];
+  entry.suit = suit;
+  entry.winnerRank = winner.rank;
+  entry.winnerHand = winner.hand;
+  entry.secondRank = second.rank;
+  entry.secondHand = second.hand;
+
+  if (secondLeft)
+    winner = second;
+  else if (! winnerLeft)
+    SetHighCard(posPoint, suit, aggr, winner);
+
+  SetHighCard(posPoint, suit,
+    aggr & static_cast<unsigned>(bitMapRank[winner.rank] - 1), second);
 }
 
 
@@ -864,7 +1007,7 @@ void Make3Simple(
   int r = mply->rank;
   s = mply->suit;
 
-  posPoint->aggr[s] ^= bitMapRank[r];
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] -= handDelta[s];
 }
 
@@ -879,8 +1022,8 @@ void Undo0(
   int s = mply.suit;
   int r = mply.rank;
 
-  posPoint->rankInSuit[h][s] |= bitMapRank[r];
-  posPoint->aggr[s] |= bitMapRank[r];
+  FlipCard(posPoint->rankInSuit[h], bitMapCard[s][r]);
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] += handDelta[s];
   posPoint->length[h][s]++;
 
@@ -907,7 +1050,7 @@ void Undo0Simple(
   int s = mply.suit;
   int r = mply.rank;
 
-  posPoint->aggr[s] |= bitMapRank[r];
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] += handDelta[s];
 }
 
@@ -921,8 +1064,8 @@ void Undo1(
   int s = mply.suit;
   int r = mply.rank;
 
-  posPoint->rankInSuit[h][s] |= bitMapRank[r];
-  posPoint->aggr[s] |= bitMapRank[r];
+  FlipCard(posPoint->rankInSuit[h], bitMapCard[s][r]);
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] += handDelta[s];
   posPoint->length[h][s]++;
 }
@@ -937,8 +1080,8 @@ void Undo2(
   int s = mply.suit;
   int r = mply.rank;
 
-  posPoint->rankInSuit[h][s] |= bitMapRank[r];
-  posPoint->aggr[s] |= bitMapRank[r];
+  FlipCard(posPoint->rankInSuit[h], bitMapCard[s][r]);
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] += handDelta[s];
   posPoint->length[h][s]++;
 }
@@ -953,13 +1096,14 @@ void Undo3(
   int s = mply.suit;
   int r = mply.rank;
 
-  posPoint->rankInSuit[h][s] |= bitMapRank[r];
-  posPoint->aggr[s] |= bitMapRank[r];
+  FlipCard(posPoint->rankInSuit[h], bitMapCard[s][r]);
+  FlipCard(posPoint->aggr, bitMapCard[s][r]);
   posPoint->handDist[h] += handDelta[s];
   posPoint->length[h][s]++;
 }
 
 
+template <class Strain>
 evalType Evaluate(
   pos const * posPoint,
   const int trump,
@@ -976,7 +1120,7 @@ evalType Evaluate(
     eval.winRanks[s] = 0;
 
   /* Who wins the last trick? */
-  if (trump != DDS_NOTRUMP) /* Highest trump card wins */
+  if (Strain::hasTrump) /* Highest trump card wins */
   {
     for (h = 0; h < DDS_HANDS; h++)
     {
@@ -1041,3 +1185,73 @@ minexit:
   return eval;
 }
 
+
+template bool ABsearch<StrainNT>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch0<StrainNT>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch1<StrainNT>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch2<StrainNT>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch3<StrainNT>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch<StrainSuit>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch0<StrainSuit>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch1<StrainSuit>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch2<StrainSuit>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template bool ABsearch3<StrainSuit>(
+  pos * posPoint,
+  const int target,
+  const int depth,
+  ThreadData * thrp);
+
+template evalType Evaluate<StrainNT>(
+  pos const * posPoint,
+  const int trump,
+  ThreadData const * thrp);
+
+template evalType Evaluate<StrainSuit>(
+  pos const * posPoint,
+  const int trump,
+  ThreadData const * thrp);
@@ -14,30 +14,35 @@
 #include "Memory.h"
 
 
+template <class Strain>
 bool ABsearch(
   pos * posPoint,
   const int target,
   const int depth,
   ThreadData * thrp);
 
+template <class Strain>
 bool ABsearch0(
   pos * posPoint,
   const int target,
   const int depth,
   ThreadData * thrp);
 
+template <class Strain>
 bool ABsearch1(
   pos * posPoint,
   const int target,
   const int depth,
   ThreadData * thrp);
 
+template <class Strain>
 bool ABsearch2(
   pos * posPoint,
   const int target,
   const int depth,
   ThreadData * thrp);
 
+template <class Strain>
 bool ABsearch3(
   pos * posPoint,
   const int target,
@@ -66,6 +71,7 @@ void Make3(
   moveType const * mply,
   ThreadData * thrp);
 
+template <class Strain>
 evalType Evaluate(
   pos const * posPoint,
   const int trump,
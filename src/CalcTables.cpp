@@ -102,6 +102,9 @@ void CalcChunkCommon(paramType &cparam,
     if (index == -1)
       break;
 
+    // The repeat may have its seats rotated. The side on lead
+    // stays the side on lead, so only the leader is mapped.
+
     if (st.repeatOf != -1)
     {
       START_THREAD_TIMER(thrId);
@@ -110,7 +113,8 @@ void CalcChunkCommon(paramType &cparam,
         cparam.bop->deals[index].first = k;
 
         cparam.solvedp->solvedBoard[index].score[k] =
-          cparam.solvedp->solvedBoard[ st.repeatOf ].score[k];
+          cparam.solvedp->solvedBoard[ st.repeatOf ].
+            score[ (k + st.rotation) & 3 ];
       }
       END_THREAD_TIMER(thrId);
       continue;
@@ -294,7 +298,9 @@ int STDCALL CalcAllTables(
 
   if ((mode > -1) && (mode < 4) && (count == 5))
   {
-    /* Calculate par */
+    /* Calculate par. Par() has its own engine for the two sides, and
+       putting its results together from the dealer survey that
+       CalcAllTablesGrid() uses changes them for some tables. */
     for (int k = 0; k < dealsp->noOfTables; k++)
     {
       res = Par(&(resp->results[k]), &(presp->presults[k]), mode);
@@ -315,9 +321,9 @@ int STDCALL CalcAllTablesPBN(
   allParResults * presp)
 {
   ddTableDeals dls;
-  for (int k = 0; k < dealsp->noOfTables; k++)
-    if (ConvertFromPBN(dealsp->deals[k].cards, dls.deals[k].cards) != 1)
-      return RETURN_PBN_FAULT;
+  if (ConvertTablesFromPBN(dealsp->deals, dealsp->noOfTables, dls.deals,
+      false, nullptr) != RETURN_NO_FAULT)
+    return RETURN_PBN_FAULT;
 
   dls.noOfTables = dealsp->noOfTables;
 
@@ -326,12 +332,51 @@ int STDCALL CalcAllTablesPBN(
 }
 
 
+int STDCALL CalcAllTablesGrid(
+  ddTableDeals * dealsp,
+  ddTablesRes * resp,
+  parResultsGrid * gridp)
+{
+  int trumpFilter[DDS_STRAINS] = {0, 0, 0, 0, 0};
+
+  int res = CalcAllTables(dealsp, -1, trumpFilter, resp, nullptr);
+  if (res != RETURN_NO_FAULT)
+    return res;
+
+  for (int k = 0; k < dealsp->noOfTables; k++)
+  {
+    res = DealerParBinGrid(&resp->results[k], &gridp[k]);
+    if (res != RETURN_NO_FAULT)
+      return res;
+  }
+
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL CalcAllTablesGridPBN(
+  ddTableDealsPBN * dealsp,
+  ddTablesRes * resp,
+  parResultsGrid * gridp)
+{
+  ddTableDeals dls;
+  if (ConvertTablesFromPBN(dealsp->deals, dealsp->noOfTables, dls.deals,
+      false, nullptr) != RETURN_NO_FAULT)
+    return RETURN_PBN_FAULT;
+
+  dls.noOfTables = dealsp->noOfTables;
+
+  return CalcAllTablesGrid(&dls, resp, gridp);
+}
+
+
 int STDCALL CalcDDtablePBN(
   ddTableDealPBN tableDealPBN,
   ddTableResults * tablep)
 {
   ddTableDeal tableDeal;
-  if (ConvertFromPBN(tableDealPBN.cards, tableDeal.cards) != 1)
+  if (ConvertTablesFromPBN(&tableDealPBN, 1, &tableDeal, false,
+      nullptr) != RETURN_NO_FAULT)
     return RETURN_PBN_FAULT;
 
   int res = CalcDDtable(tableDeal, tablep);
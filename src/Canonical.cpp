@@ -0,0 +1,184 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include "Canonical.h"
+
+
+#define CANON_KEY (DDS_HANDS + 3)
+
+void MakeRotation(
+  const deal& dl,
+  const int rotation,
+  dealCanonical& canon);
+
+bool GreaterKey(
+  const unsigned key1[],
+  const unsigned key2[]);
+
+int CompareCanonical(
+  const dealCanonical& canon1,
+  const dealCanonical& canon2);
+
+
+void MakeRotation(
+  const deal& dl,
+  const int rotation,
+  dealCanonical& canon)
+{
+  // The key of a suit is what happens in it: The holdings of the
+  // (rotated) hands, and then any cards of it in the current trick.
+  unsigned key[DDS_SUITS][CANON_KEY];
+
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    for (int h = 0; h < DDS_HANDS; h++)
+      key[s][(h + rotation) & 3] = dl.remainCards[h][s];
+
+    for (int k = 0; k < 3; k++)
+      key[s][DDS_HANDS + k] = (dl.currentTrickRank[k] != 0 &&
+        dl.currentTrickSuit[k] == s ?
+        static_cast<unsigned>(dl.currentTrickRank[k]) : 0);
+  }
+
+  // The trump suit comes first, and the others follow by key.
+  int order[DDS_SUITS];
+  int num = 0;
+
+  if (dl.trump != DDS_NOTRUMP)
+    order[num++] = dl.trump;
+
+  const int sideFrom = num;
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    if (s == dl.trump)
+      continue;
+
+    int j = num;
+    for (; j > sideFrom && GreaterKey(key[s], key[order[j-1]]); j--)
+      order[j] = order[j-1];
+    order[j] = s;
+    num++;
+  }
+
+  for (int c = 0; c < DDS_SUITS; c++)
+  {
+    const int s = order[c];
+    canon.suitOf[s] = c;
+
+    for (int h = 0; h < DDS_HANDS; h++)
+      canon.dl.remainCards[h][c] = key[s][h];
+  }
+
+  canon.dl.trump = (dl.trump == DDS_NOTRUMP ? DDS_NOTRUMP : 0);
+  canon.dl.first = (dl.first + rotation) & 3;
+
+  for (int k = 0; k < 3; k++)
+  {
+    canon.dl.currentTrickRank[k] = dl.currentTrickRank[k];
+    canon.dl.currentTrickSuit[k] = (dl.currentTrickRank[k] == 0 ? 0 :
+      canon.suitOf[dl.currentTrickSuit[k]]);
+  }
+
+  canon.rotation = rotation;
+}
+
+
+bool GreaterKey(
+  const unsigned key1[],
+  const unsigned key2[])
+{
+  for (int i = 0; i < CANON_KEY; i++)
+  {
+    if (key1[i] != key2[i])
+      return (key1[i] > key2[i]);
+  }
+  return false;
+}
+
+
+int CompareCanonical(
+  const dealCanonical& canon1,
+  const dealCanonical& canon2)
+{
+  const deal& dl1 = canon1.dl;
+  const deal& dl2 = canon2.dl;
+
+  for (int h = 0; h < DDS_HANDS; h++)
+    for (int s = 0; s < DDS_SUITS; s++)
+      if (dl1.remainCards[h][s] != dl2.remainCards[h][s])
+        return (dl1.remainCards[h][s] < dl2.remainCards[h][s] ? -1 : 1);
+
+  if (dl1.first != dl2.first)
+    return (dl1.first < dl2.first ? -1 : 1);
+
+  for (int k = 0; k < 3; k++)
+  {
+    if (dl1.currentTrickSuit[k] != dl2.currentTrickSuit[k])
+      return (dl1.currentTrickSuit[k] < dl2.currentTrickSuit[k] ? -1 : 1);
+    if (dl1.currentTrickRank[k] != dl2.currentTrickRank[k])
+      return (dl1.currentTrickRank[k] < dl2.currentTrickRank[k] ? -1 : 1);
+  }
+  return 0;
+}
+
+
+void MakeCanonical(
+  const deal& dl,
+  dealCanonical& canon)
+{
+  dealCanonical rotated;
+  MakeRotation(dl, 0, canon);
+  MakeRotation(dl, 2, rotated);
+
+  if (CompareCanonical(rotated, canon) < 0)
+    canon = rotated;
+}
+
+
+bool SameCanonicalCards(
+  const dealCanonical& canon1,
+  const dealCanonical& canon2)
+{
+  if (canon1.dl.trump != canon2.dl.trump)
+    return false;
+
+  for (int h = 0; h < DDS_HANDS; h++)
+    for (int s = 0; s < DDS_SUITS; s++)
+      if (canon1.dl.remainCards[h][s] != canon2.dl.remainCards[h][s])
+        return false;
+
+  return true;
+}
+
+
+int STDCALL CanonicalDeal(
+  deal dl,
+  dealCanonical * canonp)
+{
+  if (dl.trump < 0 || dl.trump > DDS_NOTRUMP)
+    return RETURN_TRUMP_WRONG;
+
+  if (dl.first < 0 || dl.first >= DDS_HANDS)
+    return RETURN_FIRST_WRONG;
+
+  for (int k = 0; k < 3; k++)
+  {
+    const int r = dl.currentTrickRank[k];
+    if (r == 0)
+      continue;
+
+    if (r < 2 || r > 14 ||
+        dl.currentTrickSuit[k] < 0 || dl.currentTrickSuit[k] >= DDS_SUITS)
+      return RETURN_SUIT_OR_RANK;
+  }
+
+  MakeCanonical(dl, * canonp);
+  return RETURN_NO_FAULT;
+}
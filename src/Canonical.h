@@ -0,0 +1,36 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+#ifndef DDS_CANONICAL_H
+#define DDS_CANONICAL_H
+
+/*
+   Deals that only differ by a permutation of the suits (keeping the
+   trump suit) or by swapping N-S with E-W have the same results.
+   MakeCanonical() turns a deal into one fixed representative, so
+   such deals can be recognised by comparing the canonical forms.
+
+   The trump suit becomes suit 0. The other suits are ordered by
+   their holdings, highest first. Of the two seat rotations, the one
+   giving the smaller deal is taken.
+*/
+
+
+#include "dds.h"
+
+
+void MakeCanonical(
+  const deal& dl,
+  dealCanonical& canon);
+
+bool SameCanonicalCards(
+  const dealCanonical& canon1,
+  const dealCanonical& canon2);
+
+#endif
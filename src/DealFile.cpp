@@ -0,0 +1,235 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Like EndgameDB.cpp this only needs MappedFile.cpp, so the dealconv
+// tool can build it without the rest of the library. The bit of a
+// card in remainCards is 1 << rank, as bitMapRank[rank] << 2 would
+// give.
+
+
+#include <fstream>
+#include <vector>
+#include <string.h>
+
+#include "DealFile.h"
+
+#define DEAL_FILE_VERSION 1
+
+struct dealFileHeaderType
+{
+  char magic[8];
+  unsigned version;
+  unsigned recordSize;
+  unsigned long long number;
+};
+
+const char dealFileMagic[8] = { 'D', 'D', 'S', 'D', 'E', 'A', 'L', '\0' };
+
+
+bool Encode(
+  const deal& dl,
+  const dealFileInfoType& info,
+  unsigned char rec[]);
+
+
+DealFile::DealFile()
+{
+  number = 0;
+  records = nullptr;
+}
+
+
+DealFile::~DealFile()
+{
+  DealFile::Close();
+}
+
+
+bool DealFile::Open(const char * fname)
+{
+  DealFile::Close();
+
+  // The records are read once and in order.
+  if (! file.Open(fname, true))
+    return false;
+
+  const unsigned long long fileSize = file.Size();
+
+  // Check that the file is one of ours, and that it is complete.
+  dealFileHeaderType header;
+  if (fileSize < sizeof(header))
+  {
+    DealFile::Close();
+    return false;
+  }
+
+  unsigned char const * base = file.Data();
+  memcpy(&header, base, sizeof(header));
+
+  if (memcmp(header.magic, dealFileMagic, sizeof(dealFileMagic)) != 0 ||
+      header.version != DEAL_FILE_VERSION ||
+      header.recordSize != DEAL_FILE_RECORD ||
+      header.number > (fileSize - sizeof(header)) / DEAL_FILE_RECORD)
+  {
+    DealFile::Close();
+    return false;
+  }
+
+  number = header.number;
+  records = base + sizeof(header);
+  return true;
+}
+
+
+void DealFile::Close()
+{
+  number = 0;
+  records = nullptr;
+  file.Close();
+}
+
+
+unsigned long long DealFile::Number() const
+{
+  return number;
+}
+
+
+bool DealFile::Read(
+  const unsigned long long first,
+  const int count,
+  deal dealsp[],
+  dealFileInfoType infop[]) const
+{
+  unsigned char const * rec = records + first * DEAL_FILE_RECORD;
+
+  for (int i = 0; i < count; i++, rec += DEAL_FILE_RECORD)
+  {
+    // The same ranges as Encode() allows.
+    if ((rec[13] & 7) > 4 || (rec[13] >> 5) != 0 || rec[14] > 14 ||
+        (rec[15] & 3) == 0 || ((rec[15] >> 2) & 3) == 3)
+      return false;
+
+    deal& dl = dealsp[i];
+    for (int h = 0; h < DDS_HANDS; h++)
+      for (int s = 0; s < DDS_SUITS; s++)
+        dl.remainCards[h][s] = 0;
+
+    int c = 0;
+    for (int s = 0; s < DDS_SUITS; s++)
+    {
+      for (int r = 14; r >= 2; r--, c++)
+      {
+        const unsigned hand = (rec[c >> 2] >> (2 * (c & 3))) & 3;
+        dl.remainCards[hand][s] |= 1u << r;
+      }
+    }
+
+    dl.trump = rec[13] & 7;
+    dl.first = (rec[13] >> 3) & 3;
+    for (int k = 0; k <= 2; k++)
+    {
+      dl.currentTrickSuit[k] = 0;
+      dl.currentTrickRank[k] = 0;
+    }
+
+    if (infop == nullptr)
+      continue;
+
+    dealFileInfoType& info = infop[i];
+    info.target = rec[14] - 1;
+    info.solutions = rec[15] & 3;
+    info.mode = (rec[15] >> 2) & 3;
+    info.dealer = (rec[15] >> 4) & 3;
+    info.vulnerable = (rec[15] >> 6) & 3;
+  }
+  return true;
+}
+
+
+bool Encode(
+  const deal& dl,
+  const dealFileInfoType& info,
+  unsigned char rec[])
+{
+  if (dl.trump < 0 || dl.trump > 4 ||
+      dl.first < 0 || dl.first >= DDS_HANDS ||
+      dl.currentTrickRank[0] != 0 ||
+      info.target < -1 || info.target > 13 ||
+      info.solutions < 1 || info.solutions > 3 ||
+      info.mode < 0 || info.mode > 2 ||
+      info.dealer < 0 || info.dealer >= DDS_HANDS ||
+      info.vulnerable < 0 || info.vulnerable > 3)
+    return false;
+
+  for (int b = 0; b < DEAL_FILE_RECORD; b++)
+    rec[b] = 0;
+
+  // Every card has to be in exactly one hand.
+  int c = 0;
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    for (int r = 14; r >= 2; r--, c++)
+    {
+      int holder = -1;
+      for (int h = 0; h < DDS_HANDS; h++)
+      {
+        if ((dl.remainCards[h][s] & (1u << r)) == 0)
+          continue;
+        if (holder != -1)
+          return false;
+        holder = h;
+      }
+
+      if (holder == -1)
+        return false;
+
+      rec[c >> 2] = static_cast<unsigned char>(rec[c >> 2] |
+        (holder << (2 * (c & 3))));
+    }
+  }
+
+  rec[13] = static_cast<unsigned char>(dl.trump | (dl.first << 3));
+  rec[14] = static_cast<unsigned char>(info.target + 1);
+  rec[15] = static_cast<unsigned char>(info.solutions |
+    (info.mode << 2) | (info.dealer << 4) | (info.vulnerable << 6));
+  return true;
+}
+
+
+bool DealFile::Write(
+  const char * fname,
+  const deal dealsp[],
+  const dealFileInfoType infop[],
+  const unsigned long long count)
+{
+  std::vector<char> bytes(sizeof(dealFileHeaderType) +
+    count * DEAL_FILE_RECORD);
+
+  dealFileHeaderType header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, dealFileMagic, sizeof(dealFileMagic));
+  header.version = DEAL_FILE_VERSION;
+  header.recordSize = DEAL_FILE_RECORD;
+  header.number = count;
+  memcpy(bytes.data(), &header, sizeof(header));
+
+  unsigned char * rec =
+    reinterpret_cast<unsigned char *>(bytes.data()) + sizeof(header);
+  for (unsigned long long i = 0; i < count; i++, rec += DEAL_FILE_RECORD)
+    if (! Encode(dealsp[i], infop[i], rec))
+      return false;
+
+  std::ofstream fout(fname, std::ios::binary);
+  if (! fout)
+    return false;
+
+  fout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  return static_cast<bool>(fout);
+}
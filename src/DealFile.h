@@ -0,0 +1,84 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+#ifndef DDS_DEALFILE_H
+#define DDS_DEALFILE_H
+
+/*
+   A compact file of complete deals, memory-mapped for reading. The
+   dealconv tool makes one from a text file in hands/.
+
+   After a 24-byte header come 16-byte records:
+
+   bytes 0-12  The holder (0-3 for N, E, S, W) of each card, two
+               bits per card, four cards per byte from the low bits
+               up. The cards go from the spade ace down to the club
+               two, i.e. card 13 * suit + 14 - rank.
+   byte 13     trump (bits 0-2) and first (bits 3-4).
+   byte 14     target + 1, so 0 for a target of -1.
+   byte 15     solutions (bits 0-1), mode (bits 2-3), dealer
+               (bits 4-5) and vulnerability (bits 6-7).
+
+   So only complete deals without any cards of the current trick
+   can go into a file.
+*/
+
+
+#include "dds.h"
+#include "MappedFile.h"
+
+#define DEAL_FILE_RECORD 16
+
+struct dealFileInfoType
+{
+  int target;
+  int solutions;
+  int mode;
+  int dealer;
+  int vulnerable;
+};
+
+
+class DealFile
+{
+  private:
+
+    unsigned long long number;
+    unsigned char const * records;
+
+    MappedFile file;
+
+  public:
+
+    DealFile();
+
+    ~DealFile();
+
+    bool Open(const char * fname);
+
+    void Close();
+
+    unsigned long long Number() const;
+
+    // Records first .. first+count-1, which must be in the file.
+    // Returns false if a record has a field out of range.
+    bool Read(
+      const unsigned long long first,
+      const int count,
+      deal dealsp[],
+      dealFileInfoType infop[]) const;
+
+    static bool Write(
+      const char * fname,
+      const deal dealsp[],
+      const dealFileInfoType infop[],
+      const unsigned long long count);
+};
+
+#endif
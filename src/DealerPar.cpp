@@ -84,6 +84,8 @@ const vector<string> NUMBER_TO_CONTRACT =
 
 const vector<string> NUMBER_TO_PLAYER = { "N", "E", "S", "W" };
 
+const vector<string> NUMBER_TO_SIDE = { "NS", "EW" };
+
 /* First index is vul: none, both, NS, EW.
    Second index is vul (0, 1) for NS and then EW. */
 int VUL_LOOKUP[4][2] = { {0, 0}, {1, 1}, {1, 0}, {0, 1} };
@@ -114,12 +116,55 @@ struct list_type
   int down;
 };
 
+/* What survey_tricks finds for a table, which does not depend on
+   the dealer or the vulnerability. list is as in survey_scores,
+   but without scores. order has the denominations of each side in
+   descending order of the contract number. */
+struct survey_type
+{
+  list_type list[2][DDS_STRAINS];
+  int order[2][DDS_STRAINS];
+  int highest_making_no[2];
+};
+
+/* One par contract before it is written out as text or binary.
+   seats is 0-3 for one player, 4 for NS and 5 for EW. delta is the
+   number of overtricks if > 0 and of undertricks if < 0. A single
+   sacrificer from sacrifice_entry has its own text form without
+   the star. */
+struct entry_type
+{
+  int no;
+  int seats;
+  int delta;
+  bool single;
+};
+
 
 #define BIGNUM 9999
 
 
+int dealer_par_entries(
+  const ddTableResults& table,
+  const survey_type& survey,
+  const int dealer,
+  const int vulnerable,
+  int& score,
+  entry_type entries[10]);
+
+void entries_as_bin(
+  const int res_no,
+  const int score,
+  const entry_type entries[10],
+  parResultsMaster& pres);
+
+void survey_tricks(
+  const ddTableResults& table,
+  survey_type& survey);
+
 void survey_scores(
   const ddTableResults& table,
+  const survey_type& survey,
   const int dealer,
   const int vul_by_side[2],
   data_type& data,
@@ -136,7 +181,7 @@ void best_sacrifice(
   int sacr[5][5],
   int& best_down);
 
-void sacrifices_as_text(
+void sacrifice_entries(
   const ddTableResults& table,
   const int side,
   const int dealer,
@@ -145,7 +190,7 @@ void sacrifices_as_text(
   const int dno,
   const list_type list[2][5],
   const int sacr[5][5],
-  char results[10][10],
+  entry_type results[10],
   int& res_no);
 
 void reduce_contract(
@@ -153,18 +198,25 @@ void reduce_contract(
   const int down,
   int& plus);
 
-string contract_as_text(
+entry_type contract_entry(
   const ddTableResults& table,
   const int side,
   const int no,
   const int dno,
   const int down);
 
-string sacrifice_as_text(
+entry_type sacrifice_entry(
   const int no,
   const int pno,
   const int down);
 
+string entry_as_text(
+  const entry_type& entry);
+
+void entry_as_bin(
+  const entry_type& entry,
+  contractType& contract);
+
 
 
 int STDCALL DealerPar(
@@ -176,6 +228,120 @@ int STDCALL DealerPar(
   /* dealer 0: North 1: East 2: South 3: West */
   /* vulnerable 0: None 1: Both 2: NS 3: EW */
 
+  survey_type survey;
+  survey_tricks(* tablep, survey);
+
+  entry_type entries[10];
+  int score;
+  const int res_no = dealer_par_entries(* tablep, survey, dealer,
+    vulnerable, score, entries);
+
+  if (res_no == -1)
+  {
+    presp->number = 1;
+    strcpy(presp->contracts[0], "pass");
+    return RETURN_NO_FAULT;
+  }
+
+  presp->score = score;
+  presp->number = res_no;
+  for (int n = 0; n < res_no; n++)
+    strcpy(presp->contracts[n], entry_as_text(entries[n]).c_str());
+
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL DealerParBin(
+  ddTableResults * tablep,
+  parResultsMaster * presp,
+  int dealer,
+  int vulnerable)
+{
+  /* dealer 0: North 1: East 2: South 3: West */
+  /* vulnerable 0: None 1: Both 2: NS 3: EW */
+
+  survey_type survey;
+  survey_tricks(* tablep, survey);
+
+  entry_type entries[10];
+  int score;
+  const int res_no = dealer_par_entries(* tablep, survey, dealer,
+    vulnerable, score, entries);
+
+  entries_as_bin(res_no, score, entries, * presp);
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL DealerParBinGrid(
+  ddTableResults * tablep,
+  parResultsGrid * presp)
+{
+  /* The survey of the tricks is shared by all 16 cases. */
+
+  survey_type survey;
+  survey_tricks(* tablep, survey);
+
+  for (int vul = 0; vul < 4; vul++)
+  {
+    for (int dealer = 0; dealer < DDS_HANDS; dealer++)
+    {
+      entry_type entries[10];
+      int score;
+      const int res_no = dealer_par_entries(* tablep, survey, dealer,
+        vul, score, entries);
+
+      entries_as_bin(res_no, score, entries, presp->results[vul][dealer]);
+    }
+  }
+
+  return RETURN_NO_FAULT;
+}
+
+
+void entries_as_bin(
+  const int res_no,
+  const int score,
+  const entry_type entries[10],
+  parResultsMaster& pres)
+{
+  if (res_no == -1)
+  {
+    /* Passed out, i.e. no par contract can be found. */
+    pres.number = 1;
+    pres.score = 0;
+    return;
+  }
+
+  pres.score = score;
+  pres.number = res_no;
+
+  /* In the order of the denominations, NT first. */
+  for (int n = 0; n < res_no; n++)
+  {
+    contractType contract;
+    entry_as_bin(entries[n], contract);
+
+    int r = n;
+    for (; r && contract.denom < pres.contracts[r - 1].denom; --r)
+      pres.contracts[r] = pres.contracts[r - 1];
+    pres.contracts[r] = contract;
+  }
+}
+
+
+int dealer_par_entries(
+  const ddTableResults& table,
+  const survey_type& survey,
+  const int dealer,
+  const int vulnerable,
+  int& score,
+  entry_type entries[10])
+{
+  /* Returns the number of par contracts, or -1 if the deal
+     should be passed out. */
+
   int const * vul_by_side = VUL_LOOKUP[vulnerable];
   data_type data;
   list_type list[2][DDS_STRAINS];
@@ -186,15 +352,12 @@ int STDCALL DealerPar(
 
 
   int num_cand;
-  survey_scores(* tablep, dealer, vul_by_side, data, num_cand, list);
+  survey_scores(table, survey, dealer, vul_by_side, data, num_cand,
+    list);
   int side = data.primacy;
 
   if (side == -1)
-  {
-    presp->number = 1;
-    strcpy(presp->contracts[0], "pass");
-    return RETURN_NO_FAULT;
-  }
+    return -1;
 
   /* Go through the contracts, starting from the highest one. */
   list_type * lists = list[side];
@@ -216,7 +379,7 @@ int STDCALL DealerPar(
     int dno = lists[n].dno;
     int target = DOWN_TARGET[no][vul_no];
 
-    best_sacrifice(* tablep, side, no, dno, dealer, list, sacr, down);
+    best_sacrifice(table, side, no, dno, dealer, list, sacr, down);
 
     if (down <= target)
     {
@@ -251,7 +414,7 @@ int STDCALL DealerPar(
   if (! sac_found || best_plus > sac)
   {
     /* The primacy side bids. */
-    presp->score = (side == 0 ? best_plus : -best_plus);
+    score = (side == 0 ? best_plus : -best_plus);
 
     for (int n = 0; n < num_cand; n++)
     {
@@ -259,8 +422,8 @@ int STDCALL DealerPar(
       int no = lists[n].no, plus;
       reduce_contract(no, sac_gap[n], plus);
 
-      strcpy(presp->contracts[res_no],
-        contract_as_text(* tablep, side, no, lists[n].dno, plus).c_str());
+      entries[res_no] = contract_entry(table, side, no, lists[n].dno,
+        plus);
       res_no++;
     }
   }
@@ -269,23 +432,68 @@ int STDCALL DealerPar(
     /* The primacy side collects the penalty. */
     int sac_vul = vul_by_side[1 - side];
     int sac_score = DOUBLED_SCORES[sac_vul][best_down];
-    presp->score = (side == 0 ? sac_score : -sac_score);
+    score = (side == 0 ? sac_score : -sac_score);
 
     for (int n = 0; n < num_cand; n++)
     {
       if (type[n] != 0 || lists[n].down != best_down) continue;
-      sacrifices_as_text(* tablep, side, dealer, best_down,
-                         lists[n].no, lists[n].dno, list, sacr,
-                         presp->contracts, res_no);
+      sacrifice_entries(table, side, dealer, best_down,
+                        lists[n].no, lists[n].dno, list, sacr,
+                        entries, res_no);
+    }
+  }
+  return res_no;
+}
+
+
+void survey_tricks(
+  const ddTableResults& table,
+  survey_type& survey)
+{
+  /* For each side and denomination, the most tricks that either
+     player can take, and the contract number that goes with it. */
+
+  for (int side = 0; side <= 1; side++)
+  {
+    int highest_making_no = 0;
+
+    for (int dno = 0; dno < DDS_STRAINS; dno++)
+    {
+      list_type * slist = &survey.list[side][dno];
+      int const * t = table.resTable[ DENOM_ORDER[dno] ];
+      const int a = t[side];
+      const int b = t[side + 2];
+      const int best = (a > b ? a : b);
+
+      const int no = 5 * (best - 7) + dno + 1;
+      slist->no = no; /* May be negative! */
+      slist->dno = dno;
+      slist->tricks = best;
+      slist->score = 0;
+      slist->down = 0;
+
+      if (best >= 7 && no > highest_making_no)
+        highest_making_no = no;
+    }
+    survey.highest_making_no[side] = highest_making_no;
+
+    /* The contract numbers are all different. */
+    int * order = survey.order[side];
+    for (int dno = 0; dno < DDS_STRAINS; dno++)
+    {
+      const int no = survey.list[side][dno].no;
+      int r = dno;
+      for (; r && no > survey.list[side][order[r - 1]].no; --r)
+        order[r] = order[r - 1];
+      order[r] = dno;
     }
   }
-  presp->number = res_no;
-  return RETURN_NO_FAULT;
 }
 
 
 void survey_scores(
   const ddTableResults& table,
+  const survey_type& survey,
   const int dealer,
   const int vul_by_side[2],
   data_type& data,
@@ -311,61 +519,9 @@ void survey_scores(
     order of the contract number (no).
   */
 
-  data_type stats[2];
-
-  for (int side = 0; side <= 1; side++)
-  {
-    int highest_making_no = 0;
-    int dearest_making_no = 0;
-    int dearest_score = 0;
-
-    for (int dno = 0; dno < DDS_STRAINS; dno++)
-    {
-      list_type * slist = &list[side][dno];
-      int const * t = table.resTable[ DENOM_ORDER[dno] ];
-      const int a = t[side];
-      const int b = t[side + 2];
-      const int best = (a > b ? a : b);
-
-      const int no = 5 * (best - 7) + dno + 1;
-      slist->no = no; /* May be negative! */
-
-      if (best < 7)
-      {
-        slist->score = 0;
-        continue;
-      }
-
-      const int score = SCORES[no][ vul_by_side[side] ];
-      slist->score = score;
-      slist->dno = dno;
-      slist->tricks = best;
-
-      if (score > dearest_score)
-      {
-        dearest_score = score;
-        dearest_making_no = no;
-      }
-      else if (score == dearest_score && no < dearest_making_no)
-      {
-        /* The lowest such, e.g. 3NT and 5C. */
-        dearest_making_no = no;
-      }
-
-      if (no > highest_making_no)
-      {
-        highest_making_no = no;
-      }
-    }
-    data_type& sside = stats[side];
-    sside.highest_making_no = highest_making_no;
-    sside.dearest_making_no = dearest_making_no;
-    sside.dearest_score = dearest_score;
-  }
-
   int primacy = 0;
-  const int s0 = stats[0].highest_making_no;
-  const int s1 = stats[1].highest_making_no;
+  const int s0 = survey.highest_making_no[0];
+  const int s1 = survey.highest_making_no[1];
   if (s0 > s1)
   {
     primacy = 0;
@@ -383,7 +539,7 @@ void survey_scores(
   {
     /* Special case, depends who can bid it first. */
     const int dno = (s0 - 1) % 5;
-    const int t_max = list[0][dno].tricks;
+    const int t_max = survey.list[0][dno].tricks;
     int const * t = table.resTable[ DENOM_ORDER[dno] ];
 
     for (int pno = dealer; pno <= dealer + 3; pno++)
@@ -395,44 +551,62 @@ void survey_scores(
     }
   }
 
-  data_type * sside = &stats[primacy];
+  data_type stats[2];
+
+  for (int side = 0; side <= 1; side++)
+  {
+    int dearest_making_no = 0;
+    int dearest_score = 0;
+
+    for (int dno = 0; dno < DDS_STRAINS; dno++)
+    {
+      list_type * slist = &list[side][dno];
+      * slist = survey.list[side][dno];
+
+      if (slist->tricks < 7)
+        continue;
+
+      const int no = slist->no;
+      const int score = SCORES[no][ vul_by_side[side] ];
+      slist->score = score;
+
+      if (score > dearest_score)
+      {
+        dearest_score = score;
+        dearest_making_no = no;
+      }
+      else if (score == dearest_score && no < dearest_making_no)
+      {
+        /* The lowest such, e.g. 3NT and 5C. */
+        dearest_making_no = no;
+      }
+    }
+    stats[side].dearest_making_no = dearest_making_no;
+    stats[side].dearest_score = dearest_score;
+  }
 
-  const int dm_no = sside->dearest_making_no;
+  const int dm_no = stats[primacy].dearest_making_no;
   data.primacy = primacy;
-  data.highest_making_no = sside->highest_making_no;
+  data.highest_making_no = survey.highest_making_no[primacy];
   data.dearest_making_no = dm_no;
-  data.dearest_score = sside->dearest_score;
+  data.dearest_score = stats[primacy].dearest_score;
 
   const int vul_primacy = vul_by_side[primacy];
   const int vul_other = vul_by_side[1 - primacy];
   data.vul_no = VUL_TO_NO[vul_primacy][vul_other];
 
-  /* Sort the scores in descending order of contract number,
+  /* The primacy side goes in descending order of contract number,
      i.e. first by score and second by contract number in case
-     the score is the same. Primitive bubble sort... */
-  int n = DDS_STRAINS;
-  do
-  {
-    int new_n = 0;
-    for (int i = 1; i < n; i++)
-    {
-      if (list[primacy][i - 1].no > list[primacy][i].no) 
-        continue;
-
-      list_type temp = list[primacy][i - 1];
-      list[primacy][i - 1] = list[primacy][i];
-      list[primacy][i] = temp;
-
-      new_n = i;
-    }
-    n = new_n;
-  }
-  while (n > 0);
+     the score is the same. */
+  list_type sorted[DDS_STRAINS];
+  for (int n = 0; n < DDS_STRAINS; n++)
+    sorted[n] = list[primacy][ survey.order[primacy][n] ];
 
   num_candidates = DDS_STRAINS;
-  for (n = 0; n < DDS_STRAINS; n++)
+  for (int n = 0; n < DDS_STRAINS; n++)
   {
-    if (list[primacy][n].no < dm_no) 
+    list[primacy][n] = sorted[n];
+    if (sorted[n].no < dm_no) 
       num_candidates--;
   }
 }
@@ -493,7 +667,7 @@ void best_sacrifice(
 }
 
 
-void sacrifices_as_text(
+void sacrifice_entries(
   const ddTableResults& table,
   const int side,
   const int dealer,
@@ -502,7 +676,7 @@ void sacrifices_as_text(
   const int dno,
   const list_type list[2][DDS_STRAINS],
   const int sacr[DDS_STRAINS][DDS_STRAINS],
-  char results[10][10],
+  entry_type results[10],
   int& res_no)
 {
   const int other = 1 - side;
@@ -516,8 +690,8 @@ void sacrifices_as_text(
     if (eno != dno)
     {
       const int no_sac = sacr_list[eno].no + 5 * best_down;
-      strcpy(results[res_no], 
-        contract_as_text(table, other, no_sac, eno, -best_down).c_str());
+      results[res_no] = 
+        contract_entry(table, other, no_sac, eno, -best_down);
       res_no++;
       continue;
     }
@@ -549,8 +723,7 @@ void sacrifices_as_text(
     const int ns0 = sac_list[0];
     if (p_hit == 1)
     {
-      strcpy(results[res_no],
-        sacrifice_as_text(ns0, pno_list[0], best_down).c_str());
+      results[res_no] = sacrifice_entry(ns0, pno_list[0], best_down);
       res_no++;
       continue;
     }
@@ -559,15 +732,15 @@ void sacrifices_as_text(
     if (ns0 == ns1)
     {
       /* Both players */
-      strcpy(results[res_no], 
-        contract_as_text(table, other, ns0, eno, -best_down).c_str());
+      results[res_no] = 
+        contract_entry(table, other, ns0, eno, -best_down);
       res_no++;
       continue;
     }
 
     const int p = (ns0 < ns1 ? 0 : 1);
-    strcpy(results[res_no],
-      sacrifice_as_text(sac_list[p], pno_list[p], best_down).c_str());
+    results[res_no] = 
+      sacrifice_entry(sac_list[p], pno_list[p], best_down);
     res_no++;
   }
 }
@@ -605,7 +778,7 @@ void reduce_contract(
 }
 
 
-string contract_as_text(
+entry_type contract_entry(
   const ddTableResults& table,
   const int side,
   const int no,
@@ -617,21 +790,59 @@ string contract_as_text(
   const int tb = t[side + 2];
   const int t_max = (ta > tb ? ta : tb);
 
-  return NUMBER_TO_CONTRACT[static_cast<unsigned>(no)] +
-    (delta < 0 ? "*-" : "-") +
-    (ta == t_max ? NUMBER_TO_PLAYER[static_cast<unsigned>(side)] : "") +
-    (tb == t_max ? NUMBER_TO_PLAYER[static_cast<unsigned>(side + 2)] : "") +
-    (delta > 0 ? "+" : "") +
-    (delta == 0 ? "" : to_string(delta));
+  entry_type entry;
+  entry.no = no;
+  if (ta == tb)
+    entry.seats = 4 + side;
+  else
+    entry.seats = (ta == t_max ? side : side + 2);
+  entry.delta = delta;
+  entry.single = false;
+  return entry;
 }
 
 
-string sacrifice_as_text(
+entry_type sacrifice_entry(
   const int no,
   const int pno,
   const int down)
 {
-  return NUMBER_TO_CONTRACT[static_cast<unsigned>(no)] + "-" +
-    NUMBER_TO_PLAYER[static_cast<unsigned>(pno)] + "-" +
-    to_string(down);
+  entry_type entry;
+  entry.no = no;
+  entry.seats = pno;
+  entry.delta = -down;
+  entry.single = true;
+  return entry;
+}
+
+
+string entry_as_text(
+  const entry_type& entry)
+{
+  const string contract = NUMBER_TO_CONTRACT[static_cast<unsigned>(entry.no)];
+  const string players = (entry.seats < 4 ?
+    NUMBER_TO_PLAYER[static_cast<unsigned>(entry.seats)] :
+    NUMBER_TO_SIDE[static_cast<unsigned>(entry.seats - 4)]);
+
+  if (entry.single)
+    return contract + "-" + players + "-" + to_string(-entry.delta);
+
+  return contract +
+    (entry.delta < 0 ? "*-" : "-") +
+    players +
+    (entry.delta > 0 ? "+" : "") +
+    (entry.delta == 0 ? "" : to_string(entry.delta));
+}
+
+
+void entry_as_bin(
+  const entry_type& entry,
+  contractType& contract)
+{
+  /* Contract numbers go 1C, 1D, 1H, 1S, 1N, 2C, ... */
+  contract.level = (entry.no + 4) / 5;
+  contract.denom = 4 - (entry.no - 1) % 5;
+  contract.seats = entry.seats;
+  contract.overTricks = (entry.delta > 0 ? entry.delta : 0);
+  contract.underTricks = (entry.delta < 0 ? -entry.delta : 0);
 }
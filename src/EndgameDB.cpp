@@ -0,0 +1,807 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+/*
+   The index of a position with t tricks left is
+
+     comp * multi(t, t, t, t) + rank
+
+   where comp numbers the sorted suit lengths and rank is the
+   lexicographic rank of the 4t holders, taken suit by suit in that
+   order and from the top of each suit down. Every hand holds t of
+   them, so there are multi(t, t, t, t) = (4t)! / (t!)^4 orderings.
+
+   The generator works backwards: each level plays one trick in
+   every way (one card per group of touching cards) and looks up the
+   rest of the play in the level below. It only needs MappedFile.cpp,
+   so the egdbgen tool can build it without the rest of the library.
+*/
+
+
+#include <atomic>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <string.h>
+
+#include "EndgameDB.h"
+
+
+#define EGDB_VERSION 1
+#define EGDB_PLAYED 4
+#define EGDB_CHUNK 0x10000
+
+struct egdbHeaderType
+{
+  char magic[8];
+  unsigned version;
+  unsigned tricks;
+  unsigned long long size[EGDB_MAX_TRICKS + 1];
+};
+
+const char egdbMagic[8] = { 'D', 'D', 'S', 'E', 'G', 'D', 'B', '\0' };
+
+
+int TrickWinner(
+  const bool trumpFlag,
+  const int playSuit[],
+  const int playIndex[]);
+
+void AfterTrick(
+  const egdbPosType& epos,
+  const int winner,
+  egdbPosType& next);
+
+
+EndgameDB::EndgameDB()
+{
+  tricks = 0;
+
+  for (int tr = 0; tr <= EGDB_MAX_TRICKS; tr++)
+    table[tr] = nullptr;
+
+  EndgameDB::SetTables();
+}
+
+
+EndgameDB::~EndgameDB()
+{
+  EndgameDB::Close();
+}
+
+
+void EndgameDB::SetTables()
+{
+  unsigned long long fact[EGDB_MAX_CARDS + 1];
+  fact[0] = 1;
+  for (int n = 1; n <= EGDB_MAX_CARDS; n++)
+    fact[n] = fact[n-1] * static_cast<unsigned long long>(n);
+
+  for (int a = 0; a <= EGDB_MAX_TRICKS; a++)
+    for (int b = 0; b <= EGDB_MAX_TRICKS; b++)
+      for (int c = 0; c <= EGDB_MAX_TRICKS; c++)
+        for (int d = 0; d <= EGDB_MAX_TRICKS; d++)
+          multi[a][b][c][d] = fact[a + b + c + d] /
+            (fact[a] * fact[b] * fact[c] * fact[d]);
+
+  size[0] = 0;
+  numComps[0] = 0;
+  for (int tr = 1; tr <= EGDB_MAX_TRICKS; tr++)
+  {
+    const int cards = DDS_HANDS * tr;
+    int comp = 0;
+    for (int flag = 0; flag < 2; flag++)
+    {
+      for (int n0 = 0; n0 <= EGDB_MAX_CARDS; n0++)
+        for (int n1 = 0; n1 <= EGDB_MAX_CARDS; n1++)
+          for (int n2 = 0; n2 <= EGDB_MAX_CARDS; n2++)
+          {
+            const int n3 = cards - n0 - n1 - n2;
+            bool canon;
+            if (n3 < 0)
+              canon = false;
+            else if (flag == 0)
+              canon = (n0 >= n1 && n1 >= n2 && n2 >= n3);
+            else
+              canon = (n0 >= 1 && n1 >= n2 && n2 >= n3);
+
+            compNo[tr][flag][n0][n1][n2] = (canon ? comp++ : -1);
+          }
+    }
+    numComps[tr] = comp;
+    size[tr] = static_cast<unsigned long long>(comp) *
+      multi[tr][tr][tr][tr];
+  }
+}
+
+
+unsigned long long EndgameDB::Rank(
+  const int tr,
+  const unsigned char holders[]) const
+{
+  int left[DDS_HANDS] = { tr, tr, tr, tr };
+  unsigned long long rank = 0;
+
+  for (int i = 0; i < DDS_HANDS * tr; i++)
+  {
+    const int h = holders[i];
+    for (int c = 0; c < h; c++)
+    {
+      if (left[c] == 0)
+        continue;
+
+      left[c]--;
+      rank += multi[left[0]][left[1]][left[2]][left[3]];
+      left[c]++;
+    }
+    left[h]--;
+  }
+  return rank;
+}
+
+
+void EndgameDB::Unrank(
+  const int tr,
+  unsigned long long rank,
+  unsigned char holders[]) const
+{
+  int left[DDS_HANDS] = { tr, tr, tr, tr };
+
+  for (int i = 0; i < DDS_HANDS * tr; i++)
+  {
+    for (int c = 0; c < DDS_HANDS; c++)
+    {
+      if (left[c] == 0)
+        continue;
+
+      left[c]--;
+      const unsigned long long m =
+        multi[left[0]][left[1]][left[2]][left[3]];
+      if (rank < m)
+      {
+        holders[i] = static_cast<unsigned char>(c);
+        break;
+      }
+      rank -= m;
+      left[c]++;
+    }
+  }
+}
+
+
+unsigned long long EndgameDB::Index(
+  const int tr,
+  const egdbPosType& epos,
+  int order[]) const
+{
+  // The trump suit stays first, the others go by length.
+  const int flag = (epos.trumpFlag ? 1 : 0);
+  for (int i = 0; i < DDS_SUITS; i++)
+    order[i] = i;
+
+  for (int i = flag + 1; i < DDS_SUITS; i++)
+  {
+    const int s = order[i];
+    int j = i;
+    while (j > flag && epos.length[order[j-1]] < epos.length[s])
+    {
+      order[j] = order[j-1];
+      j--;
+    }
+    order[j] = s;
+  }
+
+  unsigned char holders[EGDB_MAX_CARDS];
+  int n = 0;
+  for (int i = 0; i < DDS_SUITS; i++)
+  {
+    const int s = order[i];
+    for (int k = 0; k < epos.length[s]; k++)
+      holders[n++] = epos.holder[s][k];
+  }
+
+  const int comp = compNo[tr][flag][epos.length[order[0]]]
+    [epos.length[order[1]]][epos.length[order[2]]];
+
+  return static_cast<unsigned long long>(comp) *
+    multi[tr][tr][tr][tr] + EndgameDB::Rank(tr, holders);
+}
+
+
+bool EndgameDB::Open(const char * fname)
+{
+  EndgameDB::Close();
+
+  if (! file.Open(fname, false))
+    return false;
+
+  const unsigned long long fileSize = file.Size();
+
+  // Check that the file is one of ours, and that it is complete.
+  egdbHeaderType header;
+  if (fileSize < sizeof(header))
+  {
+    EndgameDB::Close();
+    return false;
+  }
+
+  unsigned char const * base = file.Data();
+  memcpy(&header, base, sizeof(header));
+
+  if (memcmp(header.magic, egdbMagic, sizeof(egdbMagic)) != 0 ||
+      header.version != EGDB_VERSION ||
+      header.tricks < 1 ||
+      header.tricks > EGDB_MAX_TRICKS)
+  {
+    EndgameDB::Close();
+    return false;
+  }
+
+  const int tmax = static_cast<int>(header.tricks);
+  unsigned long long offset = sizeof(header);
+  for (int tr = 1; tr <= tmax; tr++)
+  {
+    if (header.size[tr] != size[tr])
+    {
+      EndgameDB::Close();
+      return false;
+    }
+    table[tr] = base + offset;
+    offset += sizeof(unsigned) * size[tr];
+  }
+
+  if (offset > fileSize)
+  {
+    EndgameDB::Close();
+    return false;
+  }
+
+  tricks = tmax;
+  return true;
+}
+
+
+void EndgameDB::Close()
+{
+  tricks = 0;
+  for (int tr = 0; tr <= EGDB_MAX_TRICKS; tr++)
+    table[tr] = nullptr;
+
+  file.Close();
+}
+
+
+int EndgameDB::Tricks() const
+{
+  return tricks;
+}
+
+
+int EndgameDB::Probe(
+  const unsigned short rankInSuit[][DDS_SUITS],
+  const int leader,
+  const int trump,
+  const int need,
+  unsigned short ranks[]) const
+{
+  unsigned short aggr[DDS_SUITS];
+  int total = 0;
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    aggr[s] = static_cast<unsigned short>(
+      rankInSuit[0][s] | rankInSuit[1][s] |
+      rankInSuit[2][s] | rankInSuit[3][s]);
+
+    for (unsigned a = aggr[s]; a; a &= a - 1)
+      total++;
+  }
+
+  if (total == 0 || total > DDS_HANDS * tricks || (total & 3))
+    return -1;
+
+  const int tr = total >> 2;
+
+  egdbPosType epos;
+  int suits[DDS_SUITS] = { 0, 1, 2, 3 };
+  epos.trumpFlag = (trump != DDS_NOTRUMP && aggr[trump] != 0);
+  if (epos.trumpFlag)
+  {
+    suits[0] = trump;
+    for (int s = 0, i = 1; s < DDS_SUITS; s++)
+      if (s != trump)
+        suits[i++] = s;
+  }
+
+  for (int i = 0; i < DDS_SUITS; i++)
+  {
+    const int s = suits[i];
+    int len = 0;
+    for (unsigned short bit = 0x1000; bit; bit >>= 1)
+    {
+      if ((aggr[s] & bit) == 0)
+        continue;
+
+      int h = 0;
+      while ((rankInSuit[h][s] & bit) == 0)
+        h++;
+      epos.holder[i][len++] =
+        static_cast<unsigned char>((h + DDS_HANDS - leader) & 3);
+    }
+    epos.length[i] = len;
+  }
+
+  int order[DDS_SUITS];
+  const unsigned long long idx = EndgameDB::Index(tr, epos, order);
+  unsigned entry;
+  memcpy(&entry, table[tr] + sizeof(entry) * idx, sizeof(entry));
+
+  const int value = static_cast<int>(entry & 3);
+  const int shift = (value >= need ? 2 : 14);
+
+  // The top cards of each suit, down to the ones that don't matter.
+  for (int i = 0; i < DDS_SUITS; i++)
+  {
+    const int s = suits[order[i]];
+    int keep = epos.length[order[i]] -
+      static_cast<int>((entry >> (shift + 3 * i)) & 7);
+    unsigned short r = 0;
+    for (unsigned short bit = 0x1000; bit && keep > 0; bit >>= 1)
+    {
+      if (aggr[s] & bit)
+      {
+        r |= bit;
+        keep--;
+      }
+    }
+    ranks[s] = r;
+  }
+
+  return value;
+}
+
+
+int EndgameDB::Lookup(
+  const int tr,
+  const egdbPosType& next,
+  const int need,
+  int relevant[]) const
+{
+  int order[DDS_SUITS];
+  const unsigned entry = built[tr][EndgameDB::Index(tr, next, order)];
+  const int value = static_cast<int>(entry & 3);
+  const int shift = (value >= need ? 2 : 14);
+
+  for (int i = 0; i < DDS_SUITS; i++)
+    relevant[order[i]] = next.length[order[i]] -
+      static_cast<int>((entry >> (shift + 3 * i)) & 7);
+
+  return value;
+}
+
+
+int EndgameDB::Solve(
+  const int tr,
+  egdbPosType& epos,
+  const int relHand,
+  int playSuit[],
+  int playIndex[],
+  int alpha,
+  int beta) const
+{
+  // Tricks for the side on lead, by plain alpha-beta.
+  if (relHand == DDS_HANDS)
+    return EndgameDB::Resolve(tr, epos, playSuit, playIndex);
+
+  bool follow = false;
+  if (relHand > 0)
+  {
+    const int led = playSuit[0];
+    for (int k = 0; k < epos.length[led] && ! follow; k++)
+      follow = (epos.holder[led][k] == relHand);
+  }
+
+  const bool maxNode = ((relHand & 1) == 0);
+  int best = (maxNode ? -1 : tr + 1);
+
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    if (follow && s != playSuit[0])
+      continue;
+
+    for (int k = 0; k < epos.length[s]; k++)
+    {
+      // Only the top card of a group of touching cards.
+      if (epos.holder[s][k] != relHand ||
+          (k > 0 && epos.holder[s][k-1] == relHand))
+        continue;
+
+      epos.holder[s][k] = EGDB_PLAYED;
+      playSuit[relHand] = s;
+      playIndex[relHand] = k;
+
+      const int v = EndgameDB::Solve(tr, epos, relHand + 1,
+        playSuit, playIndex, alpha, beta);
+
+      epos.holder[s][k] = static_cast<unsigned char>(relHand);
+
+      if (maxNode)
+      {
+        best = std::max(best, v);
+        alpha = std::max(alpha, best);
+      }
+      else
+      {
+        best = std::min(best, v);
+        beta = std::min(beta, best);
+      }
+
+      if (alpha >= beta)
+        return best;
+    }
+  }
+  return best;
+}
+
+
+int TrickWinner(
+  const bool trumpFlag,
+  const int playSuit[],
+  const int playIndex[])
+{
+  int winner = 0;
+  for (int h = 1; h < DDS_HANDS; h++)
+  {
+    if (playSuit[h] == playSuit[winner])
+    {
+      if (playIndex[h] < playIndex[winner])
+        winner = h;
+    }
+    else if (trumpFlag && playSuit[h] == 0)
+      winner = h;
+  }
+  return winner;
+}
+
+
+void AfterTrick(
+  const egdbPosType& epos,
+  const int winner,
+  egdbPosType& next)
+{
+  // The rest of the play, seen from the winner of the trick.
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    int len = 0;
+    for (int k = 0; k < epos.length[s]; k++)
+    {
+      const int h = epos.holder[s][k];
+      if (h != EGDB_PLAYED)
+        next.holder[s][len++] =
+          static_cast<unsigned char>((h + DDS_HANDS - winner) & 3);
+    }
+    next.length[s] = len;
+  }
+  next.trumpFlag = (epos.trumpFlag && next.length[0] > 0);
+}
+
+
+int EndgameDB::Resolve(
+  const int tr,
+  const egdbPosType& epos,
+  const int playSuit[],
+  const int playIndex[]) const
+{
+  const int winner = TrickWinner(epos.trumpFlag, playSuit, playIndex);
+  const int won = ((winner & 1) == 0 ? 1 : 0);
+  if (tr == 1)
+    return won;
+
+  egdbPosType next;
+  AfterTrick(epos, winner, next);
+
+  int relevant[DDS_SUITS];
+  const int rest = EndgameDB::Lookup(tr - 1, next, 0, relevant);
+  return (won ? 1 + rest : tr - 1 - rest);
+}
+
+
+bool EndgameDB::Prove(
+  const int tr,
+  egdbPosType& epos,
+  const int relHand,
+  int playSuit[],
+  int playIndex[],
+  const int need,
+  int relevant[]) const
+{
+  /* Whether the side on lead takes at least need tricks, with the
+     number of top cards of each suit that the answer depends on.
+     As in ABsearch, a success depends on one move that succeeds,
+     and a failure on all the moves. As there is time, all moves
+     are tried, and the success that depends on the fewest cards
+     is kept. */
+
+  if (relHand == DDS_HANDS)
+    return EndgameDB::ProveResolve(tr, epos, playSuit, playIndex,
+      need, relevant);
+
+  bool follow = false;
+  if (relHand > 0)
+  {
+    const int led = playSuit[0];
+    for (int k = 0; k < epos.length[led] && ! follow; k++)
+      follow = (epos.holder[led][k] == relHand);
+  }
+
+  const bool maxNode = ((relHand & 1) == 0);
+  for (int s = 0; s < DDS_SUITS; s++)
+    relevant[s] = 0;
+
+  bool found = false;
+  int bestCost = 0;
+  int best[DDS_SUITS];
+
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    if (follow && s != playSuit[0])
+      continue;
+
+    for (int k = 0; k < epos.length[s]; k++)
+    {
+      if (epos.holder[s][k] != relHand ||
+          (k > 0 && epos.holder[s][k-1] == relHand))
+        continue;
+
+      epos.holder[s][k] = EGDB_PLAYED;
+      playSuit[relHand] = s;
+      playIndex[relHand] = k;
+
+      int rel[DDS_SUITS];
+      const bool v = EndgameDB::Prove(tr, epos, relHand + 1,
+        playSuit, playIndex, need, rel);
+
+      epos.holder[s][k] = static_cast<unsigned char>(relHand);
+
+      if (v == maxNode)
+      {
+        // Of the moves that succeed, keep the one that depends on
+        // the fewest cards.
+        const int cost = rel[0] + rel[1] + rel[2] + rel[3];
+        if (! found || cost < bestCost)
+        {
+          found = true;
+          bestCost = cost;
+          for (int ss = 0; ss < DDS_SUITS; ss++)
+            best[ss] = rel[ss];
+        }
+      }
+      else if (! found)
+      {
+        for (int ss = 0; ss < DDS_SUITS; ss++)
+          relevant[ss] = std::max(relevant[ss], rel[ss]);
+      }
+    }
+  }
+
+  if (! found)
+    return ! maxNode;
+
+  for (int ss = 0; ss < DDS_SUITS; ss++)
+    relevant[ss] = best[ss];
+  return maxNode;
+}
+
+
+bool EndgameDB::ProveResolve(
+  const int tr,
+  const egdbPosType& epos,
+  const int playSuit[],
+  const int playIndex[],
+  const int need,
+  int relevant[]) const
+{
+  const int winner = TrickWinner(epos.trumpFlag, playSuit, playIndex);
+  const int won = ((winner & 1) == 0 ? 1 : 0);
+
+  // When the trick is won by rank, the winning card matters.
+  for (int s = 0; s < DDS_SUITS; s++)
+    relevant[s] = 0;
+
+  const int ws = playSuit[winner];
+  int count = 0;
+  for (int h = 0; h < DDS_HANDS; h++)
+    if (playSuit[h] == ws)
+      count++;
+
+  if (count >= 2)
+    relevant[ws] = playIndex[winner] + 1;
+
+  if (need - won <= 0)
+    return true;
+  if (need - won > tr - 1)
+    return false;
+
+  egdbPosType next;
+  AfterTrick(epos, winner, next);
+
+  // What the winner's side needs from the rest of the play.
+  const int restNeed = (won ? need - 1 : tr - need);
+  int rel[DDS_SUITS];
+  const int rest = EndgameDB::Lookup(tr - 1, next, restNeed, rel);
+  const int ours = (won ? 1 + rest : tr - 1 - rest);
+
+  // Back from the cards of the next trick to those of this one.
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    int n = rel[s];
+    if (n == 0)
+      continue;
+
+    int k = 0;
+    while (true)
+    {
+      if (epos.holder[s][k] != EGDB_PLAYED && --n == 0)
+        break;
+      k++;
+    }
+    relevant[s] = std::max(relevant[s], k + 1);
+  }
+
+  return (ours >= need);
+}
+
+
+void EndgameDB::GenerateRange(
+  const int tr,
+  const int comp,
+  const bool trumpFlag,
+  const int lengths[],
+  const unsigned long long first,
+  const unsigned long long last)
+{
+  const int cards = DDS_HANDS * tr;
+  const unsigned long long base =
+    static_cast<unsigned long long>(comp) * multi[tr][tr][tr][tr];
+
+  unsigned char holders[EGDB_MAX_CARDS];
+  EndgameDB::Unrank(tr, first, holders);
+
+  egdbPosType epos;
+  epos.trumpFlag = trumpFlag;
+  for (int s = 0; s < DDS_SUITS; s++)
+    epos.length[s] = lengths[s];
+
+  int playSuit[DDS_HANDS], playIndex[DDS_HANDS];
+
+  for (unsigned long long r = first; r < last; r++)
+  {
+    int n = 0;
+    for (int s = 0; s < DDS_SUITS; s++)
+      for (int k = 0; k < lengths[s]; k++)
+        epos.holder[s][k] = holders[n++];
+
+    const int value =
+      EndgameDB::Solve(tr, epos, 0, playSuit, playIndex, -1, tr + 1);
+
+    // The cards that prove "at least value", and "no more".
+    int lower[DDS_SUITS] = { 0, 0, 0, 0 };
+    int upper[DDS_SUITS] = { 0, 0, 0, 0 };
+    if (value > 0)
+      EndgameDB::Prove(tr, epos, 0, playSuit, playIndex, value, lower);
+    if (value < tr)
+      EndgameDB::Prove(tr, epos, 0, playSuit, playIndex, value + 1, upper);
+
+    // The suits of a generated position are already in index order.
+    unsigned entry = static_cast<unsigned>(value);
+    for (int s = 0; s < DDS_SUITS; s++)
+    {
+      entry |= static_cast<unsigned>(
+        std::min(lengths[s] - lower[s], 7)) << (2 + 3 * s);
+      entry |= static_cast<unsigned>(
+        std::min(lengths[s] - upper[s], 7)) << (14 + 3 * s);
+    }
+
+    built[tr][base + r] = entry;
+
+    std::next_permutation(holders, holders + cards);
+  }
+}
+
+
+bool EndgameDB::Generate(
+  const int maxTricks,
+  const char * fname,
+  const int numThreads)
+{
+  if (maxTricks < 1 || maxTricks > EGDB_MAX_TRICKS || numThreads < 1)
+    return false;
+
+  for (int tr = 1; tr <= maxTricks; tr++)
+  {
+    const int cards = DDS_HANDS * tr;
+    built[tr].assign(size[tr], 0);
+
+    // The trump flag and the suit lengths of each comp.
+    std::vector<std::vector<int>> compLengths(
+      static_cast<unsigned>(numComps[tr]));
+    for (int flag = 0; flag < 2; flag++)
+      for (int n0 = 0; n0 <= cards; n0++)
+        for (int n1 = 0; n1 <= cards - n0; n1++)
+          for (int n2 = 0; n2 <= cards - n0 - n1; n2++)
+          {
+            const int comp = compNo[tr][flag][n0][n1][n2];
+            if (comp >= 0)
+              compLengths[static_cast<unsigned>(comp)] =
+                { flag, n0, n1, n2, cards - n0 - n1 - n2 };
+          }
+
+    const unsigned long long perComp = multi[tr][tr][tr][tr];
+    const unsigned long long chunksPerComp =
+      (perComp + EGDB_CHUNK - 1) / EGDB_CHUNK;
+    const unsigned long long numChunks =
+      chunksPerComp * static_cast<unsigned long long>(numComps[tr]);
+    std::atomic<unsigned long long> nextChunk(0);
+
+    auto worker = [&]()
+    {
+      while (true)
+      {
+        const unsigned long long c = nextChunk++;
+        if (c >= numChunks)
+          break;
+
+        const int comp = static_cast<int>(c / chunksPerComp);
+        const unsigned long long first = (c % chunksPerComp) * EGDB_CHUNK;
+        const unsigned long long last = std::min(first + EGDB_CHUNK, perComp);
+        std::vector<int> const& cl =
+          compLengths[static_cast<unsigned>(comp)];
+        EndgameDB::GenerateRange(tr, comp, cl[0] != 0, &cl[1],
+          first, last);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < numThreads; t++)
+      threads.emplace_back(worker);
+    worker();
+    for (std::thread& th: threads)
+      th.join();
+  }
+
+  egdbHeaderType header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, egdbMagic, sizeof(egdbMagic));
+  header.version = EGDB_VERSION;
+  header.tricks = static_cast<unsigned>(maxTricks);
+  for (int tr = 1; tr <= maxTricks; tr++)
+    header.size[tr] = size[tr];
+
+  std::ofstream fout(fname, std::ios::binary);
+  if (! fout)
+    return false;
+
+  char headerBytes[sizeof(header)];
+  memcpy(headerBytes, &header, sizeof(header));
+  fout.write(headerBytes, sizeof(header));
+
+  for (int tr = 1; tr <= maxTricks; tr++)
+  {
+    std::vector<char> bytes(sizeof(unsigned) * size[tr]);
+    memcpy(bytes.data(), built[tr].data(), bytes.size());
+    fout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+
+  for (int tr = 1; tr <= maxTricks; tr++)
+  {
+    built[tr].clear();
+    built[tr].shrink_to_fit();
+  }
+
+  return static_cast<bool>(fout);
+}
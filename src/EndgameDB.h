@@ -0,0 +1,168 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+#ifndef DDS_ENDGAMEDB_H
+#define DDS_ENDGAMEDB_H
+
+/*
+   A precomputed table of exact trick counts for small endings,
+   memory-mapped from a file made by the egdbgen tool.
+
+   A position is indexed by what decides the play and nothing else:
+   the relative ranks of the cards left, who holds each of them
+   (relative to the hand on lead), and whether there is a trump suit
+   with cards left. The non-trump suits are put in order of length,
+   so most suit permutations of a position share an entry.
+
+   An entry is 32 bits. Bits 0-1 are the number of tricks the side
+   on lead takes. Then come two sets of 4 x 3 bits, one per suit in
+   index order, with the number of cards at the bottom of the suit
+   (at most 7) that don't matter: bits 2-13 for taking that many
+   tricks, and bits 14-25 for not taking more. Like winRanks in the
+   search, this lets a result stand for similar positions in the TT.
+
+   Four tricks would need some 70 GB, so the coverage stops at three.
+*/
+
+
+#include <vector>
+
+#include "dds.h"
+#include "MappedFile.h"
+
+#define EGDB_MAX_TRICKS 3
+#define EGDB_MAX_CARDS (DDS_HANDS * EGDB_MAX_TRICKS)
+
+struct egdbPosType
+{
+  // If trumpFlag is set, suit 0 is the trump suit.
+  bool trumpFlag;
+  int length[DDS_SUITS];
+
+  // The hand (relative to the leader) holding each card of a suit,
+  // from the highest card down.
+  unsigned char holder[DDS_SUITS][EGDB_MAX_CARDS];
+};
+
+
+class EndgameDB
+{
+  private:
+
+    int tricks;
+
+    // Per number of tricks left.
+    unsigned long long size[EGDB_MAX_TRICKS + 1];
+    unsigned char const * table[EGDB_MAX_TRICKS + 1];
+
+    // Number of ways to order the holders of the cards, by the
+    // number of cards each hand still has.
+    unsigned long long multi[EGDB_MAX_TRICKS + 1][EGDB_MAX_TRICKS + 1]
+      [EGDB_MAX_TRICKS + 1][EGDB_MAX_TRICKS + 1];
+
+    // Ordinal of the (sorted) suit lengths n0, n1, n2, or -1.
+    int compNo[EGDB_MAX_TRICKS + 1][2][EGDB_MAX_CARDS + 1]
+      [EGDB_MAX_CARDS + 1][EGDB_MAX_CARDS + 1];
+    int numComps[EGDB_MAX_TRICKS + 1];
+
+    MappedFile file;
+
+    // Only used while generating.
+    std::vector<unsigned> built[EGDB_MAX_TRICKS + 1];
+
+    void SetTables();
+
+    unsigned long long Index(
+      const int tr,
+      const egdbPosType& epos,
+      int order[]) const;
+
+    unsigned long long Rank(
+      const int tr,
+      const unsigned char holders[]) const;
+
+    void Unrank(
+      const int tr,
+      unsigned long long rank,
+      unsigned char holders[]) const;
+
+    int Solve(
+      const int tr,
+      egdbPosType& epos,
+      const int relHand,
+      int playSuit[],
+      int playIndex[],
+      int alpha,
+      int beta) const;
+
+    int Resolve(
+      const int tr,
+      const egdbPosType& epos,
+      const int playSuit[],
+      const int playIndex[]) const;
+
+    bool Prove(
+      const int tr,
+      egdbPosType& epos,
+      const int relHand,
+      int playSuit[],
+      int playIndex[],
+      const int need,
+      int relevant[]) const;
+
+    bool ProveResolve(
+      const int tr,
+      const egdbPosType& epos,
+      const int playSuit[],
+      const int playIndex[],
+      const int need,
+      int relevant[]) const;
+
+    int Lookup(
+      const int tr,
+      const egdbPosType& next,
+      const int need,
+      int relevant[]) const;
+
+    void GenerateRange(
+      const int tr,
+      const int comp,
+      const bool trumpFlag,
+      const int lengths[],
+      const unsigned long long first,
+      const unsigned long long last);
+
+  public:
+
+    EndgameDB();
+
+    ~EndgameDB();
+
+    bool Open(const char * fname);
+
+    void Close();
+
+    int Tricks() const;
+
+    // Tricks for the side on lead, or -1 if not covered. ranks
+    // gets the cards that decide whether it takes need tricks.
+    int Probe(
+      const unsigned short rankInSuit[][DDS_SUITS],
+      const int leader,
+      const int trump,
+      const int need,
+      unsigned short ranks[]) const;
+
+    bool Generate(
+      const int maxTricks,
+      const char * fname,
+      const int numThreads);
+};
+
+#endif
@@ -30,6 +30,8 @@ class File
 
     File();
 
+    File(File&&) = default;
+
     ~File();
 
     void Reset();
@@ -12,6 +12,8 @@
 #include <string.h>
 
 #include "Init.h"
+#include "EndgameDB.h"
+#include "DealFile.h"
 #include "System.h"
 #include "Scheduler.h"
 #include "ThreadMgr.h"
@@ -20,6 +22,8 @@
 
 System sysdep;
 Memory memory;
+EndgameDB endgameDB;
+DealFile dealFile;
 
 void InitConstants();
 
@@ -41,6 +45,11 @@ unsigned short int bitMapRank[16] =
   0x0040, 0x0080, 0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000
 };
 
+// bitMapCard[suit][absolute rank] is the bit of that card in the
+// 64-bit bitboards of pos (rankInSuit[hand] and aggr).
+
+unsigned long long bitMapCard[DDS_SUITS][16];
+
 unsigned char cardRank[16] =
 {
   'x', 'x', '2', '3', '4', '5', '6', '7',
@@ -179,6 +188,21 @@ int STDCALL SetThreading(int)
 
 void InitConstants()
 {
+  // The bitboards are the per-suit words copied into 64 bits, so
+  // we let memcpy tell us where each suit ends up in them.
+  static_assert(sizeof(unsigned short) * DDS_SUITS ==
+    sizeof(unsigned long long), "Four suit words make a bitboard");
+
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    for (int r = 0; r < 16; r++)
+    {
+      unsigned short int suitWords[DDS_SUITS] = {0, 0, 0, 0};
+      suitWords[s] = bitMapRank[r];
+      memcpy(&bitMapCard[s][r], suitWords, sizeof(suitWords));
+    }
+  }
+
   // highestRank[aggr] is the highest absolute rank in the
   // suit represented by aggr. The absolute rank is 2 .. 14.
   // Similarly for lowestRank.
@@ -587,6 +611,18 @@ void STDCALL GetDDSInfo(DDSInfo * info)
 }
 
 
+void STDCALL GetDDSStats(DDSStats * stats)
+{
+  memory.GetStats(* stats);
+}
+
+
+void STDCALL ResetDDSStats()
+{
+  memory.ResetStats();
+}
+
+
 void STDCALL FreeMemory()
 {
   for (unsigned thrId = 0; thrId < memory.NumThreads(); thrId++)
@@ -594,6 +630,43 @@ void STDCALL FreeMemory()
 }
 
 
+int STDCALL SetEndgameDatabase(const char * fname)
+{
+  if (fname == nullptr || fname[0] == '\0')
+  {
+    endgameDB.Close();
+    return RETURN_NO_FAULT;
+  }
+
+  return (endgameDB.Open(fname) ? RETURN_NO_FAULT : RETURN_ENDGAME_DB);
+}
+
+
+int STDCALL SetDealFile(
+  const char * fname,
+  int * numberp)
+{
+  if (fname == nullptr || fname[0] == '\0')
+  {
+    dealFile.Close();
+    return RETURN_NO_FAULT;
+  }
+
+  if (! dealFile.Open(fname))
+    return RETURN_DEAL_FILE;
+
+  if (dealFile.Number() > 0x7fffffff)
+  {
+    dealFile.Close();
+    return RETURN_DEAL_FILE;
+  }
+
+  if (numberp)
+    * numberp = static_cast<int>(dealFile.Number());
+  return RETURN_NO_FAULT;
+}
+
+
 double ThreadMemoryUsed()
 {
   // TODO:  Only needed because SolverIF wants to set it. Avoid?
@@ -690,6 +763,15 @@ void STDCALL ErrorMessage(int code, char line[80])
     case RETURN_CHUNK_SIZE:
       strcpy(line, TEXT_CHUNK_SIZE);
       break;
+    case RETURN_ENDGAME_DB:
+      strcpy(line, TEXT_ENDGAME_DB);
+      break;
+    case RETURN_NO_SESSION:
+      strcpy(line, TEXT_NO_SESSION);
+      break;
+    case RETURN_DEAL_FILE:
+      strcpy(line, TEXT_DEAL_FILE);
+      break;
     default:
       strcpy(line, "Not a DDS error code");
       break;
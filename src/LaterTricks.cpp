@@ -12,6 +12,7 @@
 #include "LaterTricks.h"
 
 
+template <class Strain>
 bool LaterTricksMIN(
   pos& tpos,
   const int hand,
@@ -20,7 +21,7 @@ bool LaterTricksMIN(
   const int trump,
   const ThreadData& thrd)
 {
-  if ((trump == DDS_NOTRUMP) || (tpos.winner[trump].rank == 0))
+  if ((! Strain::hasTrump) || (tpos.winner[trump].rank == 0))
   {
     int sum = 0;
     for (int ss = 0; ss < DDS_SUITS; ss++)
@@ -145,6 +146,7 @@ bool LaterTricksMIN(
 }
 
 
+template <class Strain>
 bool LaterTricksMAX(
   pos& tpos,
   const int hand,
@@ -153,7 +155,7 @@ bool LaterTricksMAX(
   const int trump,
   const ThreadData& thrd)
 {
-  if ((trump == DDS_NOTRUMP) || (tpos.winner[trump].rank == 0))
+  if ((! Strain::hasTrump) || (tpos.winner[trump].rank == 0))
   {
     int sum = 0;
     for (int ss = 0; ss < DDS_SUITS; ss++)
@@ -282,3 +284,35 @@ bool LaterTricksMAX(
   return false;
 }
 
+
+template bool LaterTricksMIN<StrainNT>(
+  pos& tpos,
+  const int hand,
+  const int depth,
+  const int target,
+  const int trump,
+  const ThreadData& thrd);
+
+template bool LaterTricksMIN<StrainSuit>(
+  pos& tpos,
+  const int hand,
+  const int depth,
+  const int target,
+  const int trump,
+  const ThreadData& thrd);
+
+template bool LaterTricksMAX<StrainNT>(
+  pos& tpos,
+  const int hand,
+  const int depth,
+  const int target,
+  const int trump,
+  const ThreadData& thrd);
+
+template bool LaterTricksMAX<StrainSuit>(
+  pos& tpos,
+  const int hand,
+  const int depth,
+  const int target,
+  const int trump,
+  const ThreadData& thrd);
@@ -14,6 +14,7 @@
 #include "Memory.h"
 
 
+template <class Strain>
 bool LaterTricksMIN(
   pos& tpos,
   const int hand,
@@ -22,6 +23,7 @@ bool LaterTricksMIN(
   const int trump,
   const ThreadData& thrd);
 
+template <class Strain>
 bool LaterTricksMAX(
   pos& tpos,
   const int hand,
@@ -0,0 +1,140 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#if defined(_WIN32)
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "MappedFile.h"
+
+
+MappedFile::MappedFile()
+{
+  addr = nullptr;
+  size = 0;
+#if defined(_WIN32)
+  fileHandle = nullptr;
+  mapHandle = nullptr;
+#endif
+}
+
+
+MappedFile::~MappedFile()
+{
+  MappedFile::Close();
+}
+
+
+bool MappedFile::Open(
+  const char * fname,
+  const bool sequential)
+{
+  MappedFile::Close();
+
+  unsigned long long fileSize;
+  void * base;
+
+#if defined(_WIN32)
+  (void) sequential; // Only a hint, and only used with mmap
+
+  HANDLE fh = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, NULL,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (fh == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER li;
+  if (! GetFileSizeEx(fh, &li))
+  {
+    CloseHandle(fh);
+    return false;
+  }
+  fileSize = static_cast<unsigned long long>(li.QuadPart);
+
+  HANDLE mh = CreateFileMapping(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mh == NULL)
+  {
+    CloseHandle(fh);
+    return false;
+  }
+
+  base = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+  if (base == NULL)
+  {
+    CloseHandle(mh);
+    CloseHandle(fh);
+    return false;
+  }
+
+  fileHandle = fh;
+  mapHandle = mh;
+#else
+  const int fd = open(fname, O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0)
+  {
+    close(fd);
+    return false;
+  }
+  fileSize = static_cast<unsigned long long>(st.st_size);
+
+  base = mmap(nullptr, static_cast<size_t>(fileSize), PROT_READ,
+    MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return false;
+
+  if (sequential)
+    madvise(base, static_cast<size_t>(fileSize), MADV_SEQUENTIAL);
+#endif
+
+  addr = base;
+  size = fileSize;
+  return true;
+}
+
+
+void MappedFile::Close()
+{
+  if (addr == nullptr)
+    return;
+
+#if defined(_WIN32)
+  UnmapViewOfFile(addr);
+  CloseHandle(mapHandle);
+  CloseHandle(fileHandle);
+  mapHandle = nullptr;
+  fileHandle = nullptr;
+#else
+  munmap(addr, static_cast<size_t>(size));
+#endif
+
+  addr = nullptr;
+  size = 0;
+}
+
+
+unsigned char const * MappedFile::Data() const
+{
+  return static_cast<unsigned char const *>(addr);
+}
+
+
+unsigned long long MappedFile::Size() const
+{
+  return size;
+}
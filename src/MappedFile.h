@@ -0,0 +1,51 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+#ifndef DDS_MAPPEDFILE_H
+#define DDS_MAPPEDFILE_H
+
+// A whole file mapped read-only into memory. It is self-contained,
+// so the egdbgen and dealconv tools can build it without the rest
+// of the library.
+
+
+class MappedFile
+{
+  private:
+
+    void * addr;
+    unsigned long long size;
+#if defined(_WIN32)
+    void * fileHandle;
+    void * mapHandle;
+#endif
+
+  public:
+
+    MappedFile();
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // If sequential is set, the file is read once and in order.
+    bool Open(
+      const char * fname,
+      const bool sequential);
+
+    void Close();
+
+    unsigned char const * Data() const;
+
+    unsigned long long Size() const;
+};
+
+#endif
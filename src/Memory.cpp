@@ -11,14 +11,22 @@
 #include "Memory.h"
 #include "Init.h"
 
+static_assert(DDS_STATS_RESET_REASONS == TT_RESET_SIZE,
+  "DDSStats must have room for every TTresetReason");
+
 
 Memory::Memory()
 {
+  ttFlag = DDS_TT_LARGE;
+  ttDefault_MB = THREADMEM_LARGE_DEF_MB;
+  ttMaximum_MB = THREADMEM_LARGE_MAX_MB;
 }
 
 
 void Memory::ReturnThread(const unsigned thrId)
 {
+  memory[thrId].sessionWorker.reset();
+  memory[thrId].sessionRun.reset();
   memory[thrId].transTable->ReturnAllMemory();
   memory[thrId].memUsed = Memory::MemoryInUseMB(thrId);
 }
@@ -46,23 +54,53 @@ void Memory::Resize(
     threadSizes.resize(n);
     for (unsigned i = oldSize; i < n; i++)
     {
-      if (flag == DDS_TT_SMALL)
-      {
-        memory[i].transTable = std::unique_ptr<TransTableS>(new TransTableS);
-        threadSizes[i] = "S";
-      }
-      else
-      {
-        memory[i].transTable = std::unique_ptr<TransTableL>(new TransTableL);
-        threadSizes[i] = "L";
-      }
-
-      memory[i].transTable->SetMemoryDefault(memDefault_MB);
-      memory[i].transTable->SetMemoryMaximum(memMaximum_MB);
-
-      memory[i].transTable->MakeTT();
+      Memory::SetupThread(memory[i], flag, memDefault_MB, memMaximum_MB);
+      threadSizes[i] = (flag == DDS_TT_SMALL ? "S" : "L");
     }
   }
+
+  ttFlag = flag;
+  ttDefault_MB = memDefault_MB;
+  ttMaximum_MB = memMaximum_MB;
+}
+
+
+void Memory::SetupThread(
+  ThreadData& thr,
+  const TTmemory flag,
+  const int memDefault_MB,
+  const int memMaximum_MB)
+{
+  if (flag == DDS_TT_SMALL)
+    thr.transTable = std::unique_ptr<TransTableS>(new TransTableS);
+  else
+    thr.transTable = std::unique_ptr<TransTableL>(new TransTableL);
+
+  thr.transTable->SetMemoryDefault(memDefault_MB);
+  thr.transTable->SetMemoryMaximum(memMaximum_MB);
+
+  thr.transTable->MakeTT();
+
+  thr.searchStats.nodes = 0;
+  thr.searchStats.quickTricksCutoffs = 0;
+  thr.searchStats.laterTricksCutoffs = 0;
+  thr.searchStats.rootSearches = 0;
+
+  for (int s = 0; s < DDS_STRAINS; s++)
+    for (int h = 0; h < DDS_HANDS; h++)
+      thr.rootScore[s][h] = -1;
+
+  thr.sessionFlag = false;
+  thr.sessionSynced = false;
+  thr.sessionSpecCards = 0;
+}
+
+
+std::unique_ptr<ThreadData> Memory::MakeSpare() const
+{
+  std::unique_ptr<ThreadData> thr(new ThreadData());
+  Memory::SetupThread(* thr, ttFlag, ttDefault_MB, ttMaximum_MB);
+  return thr;
 }
 
 
@@ -95,3 +133,48 @@ string Memory::ThreadSize(const unsigned thrId) const
   return threadSizes[thrId];
 }
 
+
+void Memory::GetStats(DDSStats& dstats) const
+{
+  dstats.ttLookups = 0;
+  dstats.ttHits = 0;
+  dstats.ttStores = 0;
+  dstats.ttReclaims = 0;
+  for (int r = 0; r < DDS_STATS_RESET_REASONS; r++)
+    dstats.ttResets[r] = 0;
+
+  dstats.abNodes = 0;
+  dstats.quickTricksCutoffs = 0;
+  dstats.laterTricksCutoffs = 0;
+  dstats.abRootSearches = 0;
+
+  for (auto& thr: memory)
+  {
+    const TTstatsType& tt = thr.transTable->GetStats();
+    dstats.ttLookups += tt.lookups;
+    dstats.ttHits += tt.hits;
+    dstats.ttStores += tt.stores;
+    dstats.ttReclaims += tt.reclaims;
+    for (int r = 0; r < DDS_STATS_RESET_REASONS; r++)
+      dstats.ttResets[r] += tt.resets[r];
+
+    dstats.abNodes += thr.searchStats.nodes;
+    dstats.quickTricksCutoffs += thr.searchStats.quickTricksCutoffs;
+    dstats.laterTricksCutoffs += thr.searchStats.laterTricksCutoffs;
+    dstats.abRootSearches += thr.searchStats.rootSearches;
+  }
+}
+
+
+void Memory::ResetStats()
+{
+  for (auto& thr: memory)
+  {
+    thr.transTable->ResetStats();
+
+    thr.searchStats.nodes = 0;
+    thr.searchStats.quickTricksCutoffs = 0;
+    thr.searchStats.laterTricksCutoffs = 0;
+    thr.searchStats.rootSearches = 0;
+  }
+}
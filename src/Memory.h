@@ -10,7 +10,11 @@
 #ifndef DDS_MEMORY_H
 #define DDS_MEMORY_H
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "TransTable.h"
@@ -54,6 +58,48 @@ struct WinnersType
 };
 
 
+struct SearchStatsType
+{
+  long long nodes;
+  long long quickTricksCutoffs;
+  long long laterTricksCutoffs;
+  long long rootSearches;
+};
+
+struct ThreadData;
+
+// The positions after the likely next cards of a game session,
+// see SetSessionSpeculation. The results up to done are final.
+struct SessionRunType
+{
+  deal dl;
+  int number;
+  int suit[13];
+  int rank[13];
+  futureTricks fut[13];
+
+  std::atomic<int> done;
+};
+
+// The worker that solves the runs of a session, one at a time, on
+// thread data of its own. A new run replaces the one that waits,
+// and it stops the one being solved. A solve is not interrupted, so
+// that run only stops after its current position.
+struct SessionWorkerType
+{
+  std::unique_ptr<ThreadData> data;
+  std::shared_ptr<SessionRunType> next;
+  bool quit;
+  std::atomic<bool> stop;
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::thread thread;
+
+  // Waits for the current position of a run, if any.
+  ~SessionWorkerType();
+};
+
 struct ThreadData
 {
   int nodeTypeStore[DDS_HANDS];
@@ -75,6 +121,26 @@ struct ThreadData
   int nodes;
   int trickNodes;
 
+  // Always-on counters, see GetDDSStats.
+  SearchStatsType searchStats;
+
+  // Root results for the current deal by strain and leader, in
+  // tricks for the leading side. They seed the next root search.
+  // -1 if not known.
+  int rootScore[DDS_STRAINS][DDS_HANDS];
+
+  // The game session on this thread, see StartSession. sessionFut
+  // is the result for sessionDeal. sessionSynced is false once the
+  // search data above no longer hold that position. sessionRun is
+  // the latest run given to sessionWorker.
+  bool sessionFlag;
+  bool sessionSynced;
+  deal sessionDeal;
+  futureTricks sessionFut;
+  int sessionSpecCards;
+  std::unique_ptr<SessionWorkerType> sessionWorker;
+  std::shared_ptr<SessionRunType> sessionRun;
+
   // Constant for a given hand.
   // 960 KB
   relRanksType rel[8192];
@@ -121,6 +187,16 @@ class Memory
 
     vector<string> threadSizes;
 
+    TTmemory ttFlag;
+    int ttDefault_MB;
+    int ttMaximum_MB;
+
+    static void SetupThread(
+      ThreadData& thr,
+      const TTmemory flag,
+      const int memDefault_MB,
+      const int memMaximum_MB);
+
   public:
 
     Memory();
@@ -137,9 +213,16 @@ class Memory
 
     ThreadData * GetPtr(const unsigned thrId);
 
+    // Thread data of the current kind that is not in the pool.
+    std::unique_ptr<ThreadData> MakeSpare() const;
+
     double MemoryInUseMB(const unsigned thrId) const;
 
     string ThreadSize(const unsigned thrId) const;
+
+    void GetStats(DDSStats& dstats) const;
+
+    void ResetStats();
 };
 
 #endif
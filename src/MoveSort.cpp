@@ -0,0 +1,458 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+
+#include "MoveSort.h"
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define DDS_SORT_AVX2
+#endif
+
+
+/*
+   The moves are sorted by descending weight. The sorting networks
+   below were tuned for DDS long ago, and the order in which they
+   leave moves of equal weight is part of the search: Change it,
+   and the node counts change with it. So every implementation here
+   has to produce exactly the same permutation as the networks.
+
+   Rather than swapping 16-byte moves around, we sort 32-bit keys
+
+     weight << 8 | (15 - position) << 4 | index
+
+   and permute the moves once at the end. The index tells where
+   a key came from. The position field is only used by the SIMD
+   code, see below.
+*/
+
+#define KEY_WEIGHT (~0xff)
+#define KEY_POSITION 0xf0
+#define KEY_INDEX 0x0f
+
+
+void SortKeys(
+  int key[],
+  const int numMoves);
+
+#ifdef DDS_SORT_AVX2
+void SortKeysAVX2(
+  int key[],
+  const int numMoves);
+#endif
+
+
+// A compare-exchange that only looks at the weights, so keys of
+// equal weight stay where they are. The mask turns the swap into
+// straight-line code without any data-dependent branch.
+
+#define CMP_SWAP(i, j) \
+  { const int d = (key[i] ^ key[j]) & \
+      -static_cast<int>((key[i] & KEY_WEIGHT) < (key[j] & KEY_WEIGHT)); \
+    key[i] ^= d; key[j] ^= d; }
+
+void SortKeys(
+  int key[],
+  const int numMoves)
+{
+  switch (numMoves)
+  {
+    case 12:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(8, 9);
+      CMP_SWAP(10, 11);
+
+      CMP_SWAP(1, 3);
+      CMP_SWAP(5, 7);
+      CMP_SWAP(9, 11);
+
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(8, 10);
+
+      CMP_SWAP(1, 2);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(9, 10);
+
+      CMP_SWAP(1, 5);
+      CMP_SWAP(6, 10);
+      CMP_SWAP(5, 9);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(6, 10);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(7, 11);
+      CMP_SWAP(3, 7);
+      CMP_SWAP(4, 8);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(7, 11);
+      CMP_SWAP(1, 4);
+      CMP_SWAP(7, 10);
+      CMP_SWAP(3, 8);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(8, 9);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(7, 9);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(6, 8);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(7, 8);
+      break;
+    case 11:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(8, 9);
+
+      CMP_SWAP(1, 3);
+      CMP_SWAP(5, 7);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(8, 10);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(9, 10);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(6, 10);
+      CMP_SWAP(5, 9);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(6, 10);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(3, 7);
+      CMP_SWAP(4, 8);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(1, 4);
+      CMP_SWAP(7, 10);
+      CMP_SWAP(3, 8);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(8, 9);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(7, 9);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(6, 8);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(7, 8);
+      break;
+    case 10:
+      CMP_SWAP(1, 8);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(5, 9);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(3, 7);
+      CMP_SWAP(0, 3);
+      CMP_SWAP(6, 9);
+      CMP_SWAP(2, 5);
+      CMP_SWAP(0, 1);
+      CMP_SWAP(3, 6);
+      CMP_SWAP(8, 9);
+      CMP_SWAP(4, 7);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 8);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(7, 9);
+
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(7, 8);
+
+      CMP_SWAP(1, 3);
+      CMP_SWAP(6, 8);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(5, 7);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(4, 5);
+      break;
+    case 9:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(7, 8);
+      CMP_SWAP(0, 1);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(0, 3);
+      CMP_SWAP(3, 6);
+      CMP_SWAP(0, 3);
+      CMP_SWAP(1, 4);
+      CMP_SWAP(4, 7);
+      CMP_SWAP(1, 4);
+      CMP_SWAP(2, 5);
+      CMP_SWAP(5, 8);
+      CMP_SWAP(2, 5);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(5, 7);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(5, 6);
+      break;
+    case 8:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(6, 7);
+
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(5, 7);
+
+      CMP_SWAP(1, 2);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(1, 5);
+
+      CMP_SWAP(2, 6);
+      CMP_SWAP(3, 7);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(3, 5);
+
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      break;
+    case 7:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      break;
+    case 6:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      break;
+    case 5:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      break;
+    case 4:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(1, 2);
+      break;
+    case 3:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(1, 2);
+      break;
+    case 2:
+      CMP_SWAP(0, 1);
+      break;
+    default:
+      // Only 13 moves end up here. A stable insertion sort, which
+      // is rare enough that its branches don't matter.
+      for (int i = 1; i < numMoves; i++)
+      {
+        const int tmp = key[i];
+        int j = i;
+        for (; j && (tmp & KEY_WEIGHT) > (key[j - 1] & KEY_WEIGHT); --j)
+          key[j] = key[j - 1];
+        key[j] = tmp;
+      }
+  }
+}
+
+
+#ifdef DDS_SORT_AVX2
+
+/*
+   Up to eight keys fit in one AVX2 register. The network of each
+   length is split into layers of disjoint compare-exchanges, keeping
+   the order of any two that touch the same position. A layer is one
+   lane permutation that brings the partners together, then min and
+   max, where the lower position of each pair takes the maximum.
+
+   min and max compare the whole key. So that keys of equal weight
+   are not swapped, the position field is rewritten after each
+   layer: The lower position always has the larger field. Unpaired
+   lanes are their own partners and keep their keys.
+*/
+
+static const int sortLayerStart[10] =
+{
+  0, 0, 0, 1, 4, 7, 12, 18, 24, 30
+};
+
+alignas(32) static const int sortPerm[30][8] =
+{
+  { 1, 0, 2, 3, 4, 5, 6, 7 }, // 2
+  { 1, 0, 2, 3, 4, 5, 6, 7 }, // 3
+  { 2, 1, 0, 3, 4, 5, 6, 7 },
+  { 0, 2, 1, 3, 4, 5, 6, 7 },
+  { 1, 0, 3, 2, 4, 5, 6, 7 }, // 4
+  { 2, 3, 0, 1, 4, 5, 6, 7 },
+  { 0, 2, 1, 3, 4, 5, 6, 7 },
+  { 1, 0, 3, 2, 4, 5, 6, 7 }, // 5
+  { 2, 3, 0, 1, 4, 5, 6, 7 },
+  { 4, 2, 1, 3, 0, 5, 6, 7 },
+  { 0, 1, 4, 3, 2, 5, 6, 7 },
+  { 0, 2, 1, 4, 3, 5, 6, 7 },
+  { 1, 0, 3, 2, 5, 4, 6, 7 }, // 6
+  { 2, 3, 0, 1, 4, 5, 6, 7 },
+  { 4, 2, 1, 3, 0, 5, 6, 7 },
+  { 0, 5, 4, 3, 2, 1, 6, 7 },
+  { 0, 2, 1, 5, 4, 3, 6, 7 },
+  { 0, 1, 2, 4, 3, 5, 6, 7 },
+  { 1, 0, 3, 2, 5, 4, 6, 7 }, // 7
+  { 2, 3, 0, 1, 6, 5, 4, 7 },
+  { 4, 2, 1, 3, 0, 6, 5, 7 },
+  { 0, 5, 6, 3, 4, 1, 2, 7 },
+  { 0, 1, 4, 5, 2, 3, 6, 7 },
+  { 0, 2, 1, 4, 3, 6, 5, 7 },
+  { 1, 0, 3, 2, 5, 4, 7, 6 }, // 8
+  { 2, 3, 0, 1, 6, 7, 4, 5 },
+  { 4, 2, 1, 7, 0, 6, 5, 3 },
+  { 0, 5, 6, 3, 4, 1, 2, 7 },
+  { 0, 1, 4, 5, 2, 3, 6, 7 },
+  { 0, 2, 1, 4, 3, 6, 5, 7 }
+};
+
+alignas(32) static const int sortHigh[30][8] =
+{
+  {  0, -1,  0,  0,  0,  0,  0,  0 }, // 2
+  {  0, -1,  0,  0,  0,  0,  0,  0 }, // 3
+  {  0,  0, -1,  0,  0,  0,  0,  0 },
+  {  0,  0, -1,  0,  0,  0,  0,  0 },
+  {  0, -1,  0, -1,  0,  0,  0,  0 }, // 4
+  {  0,  0, -1, -1,  0,  0,  0,  0 },
+  {  0,  0, -1,  0,  0,  0,  0,  0 },
+  {  0, -1,  0, -1,  0,  0,  0,  0 }, // 5
+  {  0,  0, -1, -1,  0,  0,  0,  0 },
+  {  0,  0, -1,  0, -1,  0,  0,  0 },
+  {  0,  0,  0,  0, -1,  0,  0,  0 },
+  {  0,  0, -1,  0, -1,  0,  0,  0 },
+  {  0, -1,  0, -1,  0, -1,  0,  0 }, // 6
+  {  0,  0, -1, -1,  0,  0,  0,  0 },
+  {  0,  0, -1,  0, -1,  0,  0,  0 },
+  {  0,  0,  0,  0, -1, -1,  0,  0 },
+  {  0,  0, -1,  0,  0, -1,  0,  0 },
+  {  0,  0,  0,  0, -1,  0,  0,  0 },
+  {  0, -1,  0, -1,  0, -1,  0,  0 }, // 7
+  {  0,  0, -1, -1,  0,  0, -1,  0 },
+  {  0,  0, -1,  0, -1,  0, -1,  0 },
+  {  0,  0,  0,  0,  0, -1, -1,  0 },
+  {  0,  0,  0,  0, -1, -1,  0,  0 },
+  {  0,  0, -1,  0, -1,  0, -1,  0 },
+  {  0, -1,  0, -1,  0, -1,  0, -1 }, // 8
+  {  0,  0, -1, -1,  0,  0, -1, -1 },
+  {  0,  0, -1,  0, -1,  0, -1, -1 },
+  {  0,  0,  0,  0,  0, -1, -1,  0 },
+  {  0,  0,  0,  0, -1, -1,  0,  0 },
+  {  0,  0, -1,  0, -1,  0, -1,  0 }
+};
+
+alignas(32) static const int sortPosition[8] =
+{
+  0xf0, 0xe0, 0xd0, 0xc0, 0xb0, 0xa0, 0x90, 0x80
+};
+
+
+void SortKeysAVX2(
+  int key[],
+  const int numMoves)
+{
+  const __m256i posMask = _mm256_set1_epi32(KEY_POSITION);
+  const __m256i pos = _mm256_load_si256(
+    reinterpret_cast<const __m256i *>(sortPosition));
+
+  __m256i keys = _mm256_loadu_si256(reinterpret_cast<__m256i *>(key));
+
+  for (int l = sortLayerStart[numMoves];
+      l < sortLayerStart[numMoves + 1]; l++)
+  {
+    const __m256i perm = _mm256_load_si256(
+      reinterpret_cast<const __m256i *>(sortPerm[l]));
+    const __m256i high = _mm256_load_si256(
+      reinterpret_cast<const __m256i *>(sortHigh[l]));
+
+    const __m256i other = _mm256_permutevar8x32_epi32(keys, perm);
+    const __m256i hi = _mm256_max_epi32(keys, other);
+    const __m256i lo = _mm256_min_epi32(keys, other);
+
+    keys = _mm256_blendv_epi8(hi, lo, high);
+    keys = _mm256_or_si256(_mm256_andnot_si256(posMask, keys), pos);
+  }
+
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(key), keys);
+}
+
+#endif
+
+
+void SortMoves(
+  moveType mply[],
+  const int numMoves)
+{
+  if (numMoves <= 1)
+    return;
+
+  alignas(32) int key[16] = { };
+  for (int k = 0; k < numMoves; k++)
+    key[k] = mply[k].weight * 256 + ((15 - k) << 4) + k;
+
+#ifdef DDS_SORT_AVX2
+  if (numMoves <= 8)
+    SortKeysAVX2(key, numMoves);
+  else
+    SortKeys(key, numMoves);
+#else
+  SortKeys(key, numMoves);
+#endif
+
+  moveType sorted[16];
+  for (int k = 0; k < numMoves; k++)
+    sorted[k] = mply[key[k] & KEY_INDEX];
+  for (int k = 0; k < numMoves; k++)
+    mply[k] = sorted[k];
+}
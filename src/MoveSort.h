@@ -0,0 +1,22 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+#ifndef DDS_MOVESORT_H
+#define DDS_MOVESORT_H
+
+#include "dds.h"
+
+
+// Sorts up to 13 moves by descending weight, in place.
+
+void SortMoves(
+  moveType mply[],
+  const int numMoves);
+
+#endif
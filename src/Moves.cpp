@@ -12,6 +12,7 @@
 #include <sstream>
 
 #include "Moves.h"
+#include "MoveSort.h"
 #include "debug.h"
 
 #ifdef DDS_MOVES
@@ -221,7 +222,7 @@ int Moves::MoveGen0(
   list.current = 0;
   list.last = numMoves - 1;
   if (numMoves != 1)
-    Moves::MergeSort();
+    SortMoves(mply, numMoves);
   return numMoves;
 }
 
@@ -288,7 +289,7 @@ int Moves::MoveGen123(
 
     (this->*WeightList[findex])(tpos);
 
-    Moves::MergeSort();
+    SortMoves(mply, numMoves);
     return numMoves;
   }
 
@@ -331,7 +332,7 @@ int Moves::MoveGen123(
   list.current = 0;
   list.last = numMoves - 1;
   if (numMoves != 1)
-    Moves::MergeSort();
+    SortMoves(mply, numMoves);
   return numMoves;
 }
 
@@ -1983,257 +1984,7 @@ void Moves::Sort(
 {
   numMoves = moveList[tricks][relHand].last + 1;
   mply = moveList[tricks][relHand].move;
-  Moves::MergeSort();
-}
-
-
-#define CMP_SWAP(i, j) if (mply[i].weight < mply[j].weight) \
-  { tmp = mply[i]; mply[i] = mply[j]; mply[j] = tmp; }
-
-void Moves::MergeSort()
-{
-  moveType tmp;
-
-  switch (numMoves)
-  {
-    case 12:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(4, 5);
-      CMP_SWAP(6, 7);
-      CMP_SWAP(8, 9);
-      CMP_SWAP(10, 11);
-
-      CMP_SWAP(1, 3);
-      CMP_SWAP(5, 7);
-      CMP_SWAP(9, 11);
-
-      CMP_SWAP(0, 2);
-      CMP_SWAP(4, 6);
-      CMP_SWAP(8, 10);
-
-      CMP_SWAP(1, 2);
-      CMP_SWAP(5, 6);
-      CMP_SWAP(9, 10);
-
-      CMP_SWAP(1, 5);
-      CMP_SWAP(6, 10);
-      CMP_SWAP(5, 9);
-      CMP_SWAP(2, 6);
-      CMP_SWAP(1, 5);
-      CMP_SWAP(6, 10);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(7, 11);
-      CMP_SWAP(3, 7);
-      CMP_SWAP(4, 8);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(7, 11);
-      CMP_SWAP(1, 4);
-      CMP_SWAP(7, 10);
-      CMP_SWAP(3, 8);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(8, 9);
-      CMP_SWAP(2, 4);
-      CMP_SWAP(7, 9);
-      CMP_SWAP(3, 5);
-      CMP_SWAP(6, 8);
-      CMP_SWAP(3, 4);
-      CMP_SWAP(5, 6);
-      CMP_SWAP(7, 8);
-      break;
-    case 11:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(4, 5);
-      CMP_SWAP(6, 7);
-      CMP_SWAP(8, 9);
-
-      CMP_SWAP(1, 3);
-      CMP_SWAP(5, 7);
-      CMP_SWAP(0, 2);
-      CMP_SWAP(4, 6);
-      CMP_SWAP(8, 10);
-      CMP_SWAP(1, 2);
-      CMP_SWAP(5, 6);
-      CMP_SWAP(9, 10);
-      CMP_SWAP(1, 5);
-      CMP_SWAP(6, 10);
-      CMP_SWAP(5, 9);
-      CMP_SWAP(2, 6);
-      CMP_SWAP(1, 5);
-      CMP_SWAP(6, 10);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(3, 7);
-      CMP_SWAP(4, 8);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(1, 4);
-      CMP_SWAP(7, 10);
-      CMP_SWAP(3, 8);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(8, 9);
-      CMP_SWAP(2, 4);
-      CMP_SWAP(7, 9);
-      CMP_SWAP(3, 5);
-      CMP_SWAP(6, 8);
-      CMP_SWAP(3, 4);
-      CMP_SWAP(5, 6);
-      CMP_SWAP(7, 8);
-      break;
-    case 10:
-      CMP_SWAP(1, 8);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(5, 9);
-      CMP_SWAP(2, 6);
-      CMP_SWAP(3, 7);
-      CMP_SWAP(0, 3);
-      CMP_SWAP(6, 9);
-      CMP_SWAP(2, 5);
-      CMP_SWAP(0, 1);
-      CMP_SWAP(3, 6);
-      CMP_SWAP(8, 9);
-      CMP_SWAP(4, 7);
-      CMP_SWAP(0, 2);
-      CMP_SWAP(4, 8);
-      CMP_SWAP(1, 5);
-      CMP_SWAP(7, 9);
-
-      CMP_SWAP(1, 2);
-      CMP_SWAP(3, 4);
-      CMP_SWAP(5, 6);
-      CMP_SWAP(7, 8);
-
-      CMP_SWAP(1, 3);
-      CMP_SWAP(6, 8);
-      CMP_SWAP(2, 4);
-      CMP_SWAP(5, 7);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(6, 7);
-      CMP_SWAP(3, 5);
-      CMP_SWAP(4, 6);
-      CMP_SWAP(4, 5);
-      break;
-    case 9:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(3, 4);
-      CMP_SWAP(6, 7);
-      CMP_SWAP(1, 2);
-      CMP_SWAP(4, 5);
-      CMP_SWAP(7, 8);
-      CMP_SWAP(0, 1);
-      CMP_SWAP(3, 4);
-      CMP_SWAP(6, 7);
-      CMP_SWAP(0, 3);
-      CMP_SWAP(3, 6);
-      CMP_SWAP(0, 3);
-      CMP_SWAP(1, 4);
-      CMP_SWAP(4, 7);
-      CMP_SWAP(1, 4);
-      CMP_SWAP(2, 5);
-      CMP_SWAP(5, 8);
-      CMP_SWAP(2, 5);
-      CMP_SWAP(1, 3);
-      CMP_SWAP(5, 7);
-      CMP_SWAP(2, 6);
-      CMP_SWAP(4, 6);
-      CMP_SWAP(2, 4);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(5, 6);
-      break;
-    case 8:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(4, 5);
-      CMP_SWAP(6, 7);
-
-      CMP_SWAP(0, 2);
-      CMP_SWAP(4, 6);
-      CMP_SWAP(1, 3);
-      CMP_SWAP(5, 7);
-
-      CMP_SWAP(1, 2);
-      CMP_SWAP(5, 6);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(1, 5);
-
-      CMP_SWAP(2, 6);
-      CMP_SWAP(3, 7);
-      CMP_SWAP(2, 4);
-      CMP_SWAP(3, 5);
-
-      CMP_SWAP(1, 2);
-      CMP_SWAP(3, 4);
-      CMP_SWAP(5, 6);
-      break;
-    case 7:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(4, 5);
-      CMP_SWAP(0, 2);
-      CMP_SWAP(4, 6);
-      CMP_SWAP(1, 3);
-      CMP_SWAP(1, 2);
-      CMP_SWAP(5, 6);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(1, 5);
-      CMP_SWAP(2, 6);
-      CMP_SWAP(2, 4);
-      CMP_SWAP(3, 5);
-      CMP_SWAP(1, 2);
-      CMP_SWAP(3, 4);
-      CMP_SWAP(5, 6);
-      break;
-    case 6:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(4, 5);
-      CMP_SWAP(0, 2);
-      CMP_SWAP(1, 3);
-      CMP_SWAP(1, 2);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(1, 5);
-      CMP_SWAP(2, 4);
-      CMP_SWAP(3, 5);
-      CMP_SWAP(1, 2);
-      CMP_SWAP(3, 4);
-      break;
-    case 5:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(0, 2);
-      CMP_SWAP(1, 3);
-      CMP_SWAP(1, 2);
-      CMP_SWAP(0, 4);
-      CMP_SWAP(2, 4);
-      CMP_SWAP(1, 2);
-      CMP_SWAP(3, 4);
-      break;
-    case 4:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(2, 3);
-      CMP_SWAP(0, 2);
-      CMP_SWAP(1, 3);
-      CMP_SWAP(1, 2);
-      break;
-    case 3:
-      CMP_SWAP(0, 1);
-      CMP_SWAP(0, 2);
-      CMP_SWAP(1, 2);
-      break;
-    case 2:
-      CMP_SWAP(0, 1);
-      break;
-    default:
-      for (int i = 1; i < numMoves; i++)
-      {
-        tmp = mply[i];
-        int j = i;
-        for (; j && tmp.weight > mply[j - 1].weight ; --j)
-          mply[j] = mply[j - 1];
-        mply[j] = tmp;
-      }
-  }
-
-  return;
+  SortMoves(mply, numMoves);
 }
 
 
@@ -155,8 +155,6 @@ class Moves
 
     string PrintMove(const movePlyType& mply) const;
 
-    void MergeSort();
-
     void UpdateStatsEntry(
       moveStatsType& stat,
       const int findex,
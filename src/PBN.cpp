@@ -8,94 +8,232 @@
 */
 
 
+#include <atomic>
+
 #include "dds.h"
 #include "PBN.h"
+#include "System.h"
+
+using namespace std;
+
+extern System sysdep;
+
+/* What a character in the cards of a PBN deal is. The bits in
+   PBN_CARD_MASK are the bit of a card in remainCards. */
+#define PBN_CARD_MASK 0xffff
+#define PBN_SUIT_END 0x10000
+#define PBN_HAND_END 0x20000
+#define PBN_UNKNOWN_HAND 0x40000
+#define PBN_INVALID 0x80000
 
 int IsCard(const char cardChar);
 
+int ParseFromPBN(
+  char const * dealBuff,
+  unsigned int remainCards[DDS_HANDS][DDS_SUITS],
+  const bool strict);
+
+int ConvertRangeFromPBN(
+  const int number,
+  int * resp,
+  const function<int(const int)>& convert);
+
+
+struct pbn_table_type
+{
+  unsigned code[256];
+  int first[256];
+
+  pbn_table_type()
+  {
+    for (int c = 0; c < 256; c++)
+    {
+      const int card = IsCard(static_cast<char>(c));
+      code[c] = (card ? static_cast<unsigned>(bitMapRank[card] << 2) :
+        PBN_INVALID);
+      first[c] = -1;
+    }
+
+    code[static_cast<unsigned char>('.')] = PBN_SUIT_END;
+    code[static_cast<unsigned char>(' ')] = PBN_HAND_END;
+    code[static_cast<unsigned char>('-')] = PBN_UNKNOWN_HAND;
+
+    const char * hands = "NESW";
+    const char * lower = "nesw";
+    for (int h = 0; h < DDS_HANDS; h++)
+    {
+      first[static_cast<unsigned char>(hands[h])] = h;
+      first[static_cast<unsigned char>(lower[h])] = h;
+    }
+  }
+};
 
-int ConvertFromPBN(
+static const pbn_table_type PBN_TABLE;
+
+
+int ParseFromPBN(
   char const * dealBuff,
-  unsigned int remainCards[DDS_HANDS][DDS_SUITS])
+  unsigned int remainCards[DDS_HANDS][DDS_SUITS],
+  const bool strict)
 {
-  for (int h = 0; h < DDS_HANDS; h++)
-    for (int s = 0; s < DDS_SUITS; s++)
-      remainCards[h][s] = 0;
+  /* Unless strict, anything that is not a card or a separator is
+     skipped as before, and only a missing first hand is a fault.
+     If strict, such characters, a missing colon, more than four
+     hands or suits, more than 13 cards in a hand and duplicate
+     cards are all faults, in that order. */
 
   int bp = 0;
-  while (((dealBuff[bp] != 'W') && (dealBuff[bp] != 'N') &&
-          (dealBuff[bp] != 'E') && (dealBuff[bp] != 'S') &&
-          (dealBuff[bp] != 'w') && (dealBuff[bp] != 'n') &&
-          (dealBuff[bp] != 'e') && (dealBuff[bp] != 's')) && (bp < 3))
+  while (bp < 3 &&
+      PBN_TABLE.first[static_cast<unsigned char>(dealBuff[bp])] == -1)
     bp++;
 
   if (bp >= 3)
-    return 0;
-
-  int first;
-  if ((dealBuff[bp] == 'N') || (dealBuff[bp] == 'n'))
-    first = 0;
-  else if ((dealBuff[bp] == 'E') || (dealBuff[bp] == 'e'))
-    first = 1;
-  else if ((dealBuff[bp] == 'S') || (dealBuff[bp] == 's'))
-    first = 2;
-  else
-    first = 3;
+  {
+    for (int h = 0; h < DDS_HANDS; h++)
+      for (int s = 0; s < DDS_SUITS; s++)
+        remainCards[h][s] = 0;
+    return RETURN_PBN_FAULT;
+  }
 
-  bp++;
-  bp++;
+  const int first =
+    PBN_TABLE.first[static_cast<unsigned char>(dealBuff[bp])];
+  const bool colon = (dealBuff[bp + 1] == ':');
+  bp += 2;
 
+  /* The loop has no branches apart from its end. A fifth hand or
+     suit is an overflow slot that the cards go into and that is
+     then left out. */
+  unsigned cells[DDS_HANDS + 1][DDS_SUITS + 1] = { };
+  int count[DDS_HANDS + 1] = { };
+  unsigned seen[DDS_SUITS + 1] = { };
+  unsigned flags = 0, duplicates = 0;
   int handRelFirst = 0;
   int suitInHand = 0;
-  int card, hand;
 
-  while ((bp < 80) && (dealBuff[bp] != '\0'))
+  for (; bp < 80 && dealBuff[bp] != '\0'; bp++)
   {
-    card = IsCard(dealBuff[bp]);
-    if (card)
-    {
-      switch (first)
-      {
-        case 0:
-          hand = handRelFirst;
-          break;
-        case 1:
-          if (handRelFirst == 0)
-            hand = 1;
-          else if (handRelFirst == 3)
-            hand = 0;
-          else
-            hand = handRelFirst + 1;
-          break;
-        case 2:
-          if (handRelFirst == 0)
-            hand = 2;
-          else if (handRelFirst == 1)
-            hand = 3;
-          else
-            hand = handRelFirst - 2;
-          break;
-        default:
-          if (handRelFirst == 0)
-            hand = 3;
-          else
-            hand = handRelFirst - 1;
-      }
-
-      remainCards[hand][suitInHand] |=
-        static_cast<unsigned>((bitMapRank[card] << 2));
+    const unsigned code =
+      PBN_TABLE.code[static_cast<unsigned char>(dealBuff[bp])];
+    const unsigned card = code & PBN_CARD_MASK;
+
+    duplicates |= seen[suitInHand] & card;
+    seen[suitInHand] |= card;
+    cells[handRelFirst][suitInHand] |= card;
+    count[handRelFirst] += (card != 0);
+    flags |= code;
+
+    const int suitEnd = ((code & PBN_SUIT_END) != 0) &
+      (suitInHand < DDS_SUITS);
+    const int handEnd = ((code & PBN_HAND_END) != 0);
+    suitInHand = (suitInHand + suitEnd) & (handEnd - 1);
+    handRelFirst += handEnd & (handRelFirst < DDS_HANDS);
+  }
+
+  for (int h = 0; h < DDS_HANDS; h++)
+    for (int s = 0; s < DDS_SUITS; s++)
+      remainCards[(first + h) & 3][s] = cells[h][s];
+
+  if (! strict)
+    return RETURN_NO_FAULT;
+
+  unsigned overflow = cells[DDS_HANDS][DDS_SUITS];
+  for (int i = 0; i < DDS_HANDS; i++)
+    overflow |= cells[i][DDS_SUITS] | cells[DDS_HANDS][i];
+
+  if (! colon || (flags & PBN_INVALID) || overflow)
+    return RETURN_PBN_FAULT;
 
+  for (int h = 0; h < DDS_HANDS; h++)
+    if (count[h] > 13)
+      return RETURN_TOO_MANY_CARDS;
+
+  if (duplicates)
+    return RETURN_DUPLICATE_CARDS;
+
+  return RETURN_NO_FAULT;
+}
+
+
+int ConvertRangeFromPBN(
+  const int number,
+  int * resp,
+  const function<int(const int)>& convert)
+{
+  std::atomic<int> ret(RETURN_NO_FAULT);
+
+  sysdep.RunThreadsRange(number, DDS_RANGE_CHUNK_SIZE,
+    [&](const int first, const int last)
+  {
+    for (int i = first; i < last; i++)
+    {
+      const int res = convert(i);
+      if (resp)
+        resp[i] = res;
+      if (res != RETURN_NO_FAULT)
+        ret = RETURN_PBN_FAULT;
     }
-    else if (dealBuff[bp] == '.')
-      suitInHand++;
-    else if (dealBuff[bp] == ' ')
+  });
+
+  return ret;
+}
+
+
+int ConvertDealsFromPBN(
+  const dealPBN * dealsp,
+  const int number,
+  deal * dlp,
+  const bool strict,
+  int * resp)
+{
+  return ConvertRangeFromPBN(number, resp, [&](const int i)
+  {
+    const dealPBN& dl = dealsp[i];
+    deal& bin = dlp[i];
+    bin.trump = dl.trump;
+    bin.first = dl.first;
+
+    for (int k = 0; k <= 2; k++)
     {
-      handRelFirst++;
-      suitInHand = 0;
+      bin.currentTrickSuit[k] = dl.currentTrickSuit[k];
+      bin.currentTrickRank[k] = dl.currentTrickRank[k];
     }
-    bp++;
-  }
-  return RETURN_NO_FAULT;
+
+    return ParseFromPBN(dl.remainCards, bin.remainCards, strict);
+  });
+}
+
+
+int ConvertTablesFromPBN(
+  const ddTableDealPBN * dealsp,
+  const int number,
+  ddTableDeal * dlp,
+  const bool strict,
+  int * resp)
+{
+  return ConvertRangeFromPBN(number, resp, [&](const int i)
+  {
+    return ParseFromPBN(dealsp[i].cards, dlp[i].cards, strict);
+  });
+}
+
+
+int STDCALL ConvertFromPBNAll(
+  dealPBN * dealsp,
+  int number,
+  deal * dlp,
+  int * resp)
+{
+  return ConvertDealsFromPBN(dealsp, number, dlp, true, resp);
+}
+
+
+int STDCALL ConvertTablesFromPBNAll(
+  ddTableDealPBN * dealsp,
+  int number,
+  ddTableDeal * dlp,
+  int * resp)
+{
+  return ConvertTablesFromPBN(dealsp, number, dlp, true, resp);
 }
 
 
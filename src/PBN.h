@@ -13,9 +13,22 @@
 #include "dds.h"
 
 
-int ConvertFromPBN(
-  char const * dealBuff,
-  unsigned int remainCards[DDS_HANDS][DDS_SUITS]);
+// The strict versions give a per-deal RETURN_PBN_FAULT,
+// RETURN_TOO_MANY_CARDS or RETURN_DUPLICATE_CARDS in resp, which
+// may be nullptr. They return RETURN_PBN_FAULT if any deal fails.
+int ConvertDealsFromPBN(
+  const dealPBN * dealsp,
+  const int number,
+  deal * dlp,
+  const bool strict,
+  int * resp);
+
+int ConvertTablesFromPBN(
+  const ddTableDealPBN * dealsp,
+  const int number,
+  ddTableDeal * dlp,
+  const bool strict,
+  int * resp);
 
 int ConvertPlayFromPBN(
   const playTracePBN& playPBN,
@@ -10,14 +10,18 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <atomic>
 #include <string.h>
 #include <cstdio>
 
 #include "dds.h"
 #include "PBN.h"
+#include "System.h"
 
 using namespace std;
 
+extern System sysdep;
+
 
 struct par_suits_type
 {
@@ -32,12 +36,6 @@ struct best_par_type
   int par_tricks;
 };
 
-struct parContr2Type
-{
-  char contracts[10];
-  int denom;
-};
-
 int stat_contr[5] = {0, 0, 0, 0, 0};
 
 /* index 1: 0=NT, 1=Major, 2=Minor index 2: contract level 1-7 */
@@ -59,7 +57,8 @@ int STDCALL CalcParPBN(
   int STDCALL CalcPar(ddTableDeal tableDeal, int vulnerable,
                       ddTableResults * tablep, parResults * presp);
 
-  if (ConvertFromPBN(tableDealPBN.cards, tableDeal.cards) != 1)
+  if (ConvertTablesFromPBN(&tableDealPBN, 1, &tableDeal, false,
+      nullptr) != RETURN_NO_FAULT)
     return RETURN_PBN_FAULT;
 
   res = CalcPar(tableDeal, vulnerable, tablep, presp);
@@ -73,6 +72,11 @@ int rawscore(
   int tricks,
   int isvul);
 
+int rawscore_calc(
+  int denom,
+  int tricks,
+  int isvul);
+
 void SideSeats(
   int dr,
   int i,
@@ -834,7 +838,33 @@ int STDCALL SidesParBin(
 
 #endif
 
+/* Scores from rawscore_calc, by denom + 1, tricks and isvul. */
+struct rawscore_table_type
+{
+  int score[6][14][2];
+
+  rawscore_table_type()
+  {
+    for (int d = 0; d < 6; d++)
+      for (int t = 0; t < 14; t++)
+        for (int v = 0; v < 2; v++)
+          score[d][t][v] = rawscore_calc(d - 1, t, v);
+  }
+};
+
+static const rawscore_table_type RAWSCORE_TABLE;
+
+
 int rawscore(int denom, int tricks, int isvul)
+{
+  if (tricks < 0 || tricks > 13)
+    return rawscore_calc(denom, tricks, isvul);
+
+  return RAWSCORE_TABLE.score[denom + 1][tricks][isvul ? 1 : 0];
+}
+
+
+int rawscore_calc(int denom, int tricks, int isvul)
 {
   int game_bonus, level, score;
 
@@ -1134,141 +1164,6 @@ int STDCALL CalcPar(
 }
 
 
-int STDCALL DealerParBin(
-  ddTableResults * tablep,
-  parResultsMaster * presp,
-  int dealer,
-  int vulnerable)
-{
-  /* dealer 0: North 1: East 2: South 3: West */
-  /* vulnerable 0: None 1: Both 2: NS 3: EW */
-
-  parResultsDealer parResDealer;
-  parContr2Type parContr2[10];
-  int k, delta;
-
-  int res = DealerPar(tablep, &parResDealer, dealer, vulnerable);
-
-  if (res != RETURN_NO_FAULT)
-  {
-    return res;
-  }
-
-  if (parResDealer.contracts[0][0] == 'p')
-  {
-    /*Passed out, i.e. no par contract can be found.*/
-    presp->number = 1;
-    presp->score = 0;
-    return RETURN_NO_FAULT;
-  }
-
-
-  for (k = 0; k < parResDealer.number; k++)
-  {
-
-    for (int u = 0; u < 10; u++)
-      parContr2[k].contracts[u] = parResDealer.contracts[k][u];
-
-    if (parResDealer.contracts[k][1] == 'N')
-      parContr2[k].denom = 0;
-    else if (parResDealer.contracts[k][1] == 'S')
-      parContr2[k].denom = 1;
-    else if (parResDealer.contracts[k][1] == 'H')
-      parContr2[k].denom = 2;
-    else if (parResDealer.contracts[k][1] == 'D')
-      parContr2[k].denom = 3;
-    else if (parResDealer.contracts[k][1] == 'C')
-      parContr2[k].denom = 4;
-  }
-
-  for (int s = 1; s < parResDealer.number; s++)
-  {
-    parContr2Type tmp = parContr2[s];
-    int r = s;
-    for (; r && tmp.denom < parContr2[r - 1].denom; --r)
-      parContr2[r] = parContr2[r - 1];
-    parContr2[r] = tmp;
-  }
-
-  presp->score = parResDealer.score;
-  presp->number = parResDealer.number;
-
-  for (k = 0; k < parResDealer.number; k++)
-  {
-    delta = 1;
-
-    presp->contracts[k].level = int(parContr2[k].contracts[0] - '0');
-
-    switch (parContr2[k].contracts[1])
-    {
-      case 'N':
-        presp->contracts[k].denom = 0;
-        break;
-      case 'S':
-        presp->contracts[k].denom = 1;
-        break;
-      case 'H':
-        presp->contracts[k].denom = 2;
-        break;
-      case 'D':
-        presp->contracts[k].denom = 3;
-        break;
-      case 'C':
-        presp->contracts[k].denom = 4;
-        break;
-      default:
-        return RETURN_UNKNOWN_FAULT;
-        // denomination not in (NSHDC)
-    }
-
-    if (strstr(parContr2[k].contracts, "NS"))
-      presp->contracts[k].seats = 4;
-    else if (strstr(parContr2[k].contracts, "EW"))
-      presp->contracts[k].seats = 5;
-    else if (strstr(parContr2[k].contracts, "-N"))
-    {
-      presp->contracts[k].seats = 0;
-      delta = 0;
-    }
-    else if (strstr(parContr2[k].contracts, "-E"))
-    {
-      presp->contracts[k].seats = 1;
-      delta = 0;
-    }
-    else if (strstr(parContr2[k].contracts, "-S"))
-    {
-      presp->contracts[k].seats = 2;
-      delta = 0;
-    }
-    else if (strstr(parContr2[k].contracts, "-W"))
-    {
-      presp->contracts[k].seats = 3;
-      delta = 0;
-    }
-
-    if (parResDealer.contracts[0][2] == '*')
-    {
-      /* Sacrifice */
-      presp->contracts[k].underTricks =
-        static_cast<int>(parContr2[k].contracts[6 + delta] - '0');
-      presp->contracts[k].overTricks = 0;
-    }
-    else
-      /* Make */
-
-    {
-      if (strchr(parContr2[k].contracts, '+'))
-        presp->contracts[k].overTricks =
-          static_cast<int>(parContr2[k].contracts[5 + delta] - '0');
-      else
-        presp->contracts[k].overTricks = 0;
-      presp->contracts[k].underTricks = 0;
-    }
-  }
-  return RETURN_NO_FAULT;
-}
-
-
 int STDCALL SidesPar(
   ddTableResults * tablep, 
   parResultsDealer sidesRes[2], 
@@ -1574,3 +1469,62 @@ int STDCALL ConvertToSidesTextFormat(
   return RETURN_NO_FAULT;
 }
 
+
+int STDCALL SidesParBinAll(
+  ddTableResults * tablep,
+  int * vulnerablep,
+  int number,
+  parResultsMaster * presp)
+{
+  /* SidesParBin() for number tables, so presp gets two results
+     per table. */
+
+  if (tablep == nullptr || vulnerablep == nullptr ||
+      presp == nullptr || number < 0)
+    return RETURN_UNKNOWN_FAULT;
+
+  std::atomic<int> ret(RETURN_NO_FAULT);
+
+  sysdep.RunThreadsRange(number, DDS_RANGE_CHUNK_SIZE,
+    [&](const int first, const int last)
+  {
+    for (int i = first; i < last; i++)
+    {
+      const int res = SidesParBin(&tablep[i], &presp[2 * i],
+        vulnerablep[i]);
+      if (res != RETURN_NO_FAULT)
+        ret = res;
+    }
+  });
+
+  return ret;
+}
+
+
+int STDCALL DealerParBinAll(
+  ddTableResults * tablep,
+  int * dealerp,
+  int * vulnerablep,
+  int number,
+  parResultsMaster * presp)
+{
+  if (tablep == nullptr || dealerp == nullptr || vulnerablep == nullptr ||
+      presp == nullptr || number < 0)
+    return RETURN_UNKNOWN_FAULT;
+
+  std::atomic<int> ret(RETURN_NO_FAULT);
+
+  sysdep.RunThreadsRange(number, DDS_RANGE_CHUNK_SIZE,
+    [&](const int first, const int last)
+  {
+    for (int i = first; i < last; i++)
+    {
+      const int res = DealerParBin(&tablep[i], &presp[i],
+        dealerp[i], vulnerablep[i]);
+      if (res != RETURN_NO_FAULT)
+        ret = res;
+    }
+  });
+
+  return ret;
+}
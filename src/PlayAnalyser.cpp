@@ -7,6 +7,8 @@
    See LICENSE and README.
 */
 
+#include <algorithm>
+
 #include "PlayAnalyser.h"
 #include "SolverIF.h"
 #include "System.h"
@@ -28,6 +30,247 @@ using namespace std;
 extern System sysdep;
 extern Memory memory;
 
+int TraceTrickWinner(
+  const deal& dl,
+  const int suit,
+  const int rank);
+
+bool OnlyOneChoice(
+  const deal& dl);
+
+int AnalysePlayCommon(
+  ThreadData * thrp,
+  deal dl,
+  const playTraceBin& play,
+  solvedPlay * solvedp,
+  const int numKnown);
+
+bool SamePlayDeal(
+  const deal& dl1,
+  const deal& dl2);
+
+bool PlayBefore(
+  const playTraceBin& play1,
+  const playTraceBin& play2);
+
+int CommonPrefix(
+  const playTraceBin& play1,
+  const playTraceBin& play2);
+
+void PlayGroupCommon(
+  playparamType& playparam,
+  const int thrId,
+  vector<int>& group);
+
+
+int TraceTrickCards(
+  const deal& dl)
+{
+  int n = 0;
+  while (n < 3 && dl.currentTrickRank[n] != 0)
+    n++;
+  return n;
+}
+
+
+int TraceHandCards(
+  const deal& dl)
+{
+  int n = 0;
+  for (int h = 0; h < DDS_HANDS; h++)
+    for (int s = 0; s < DDS_SUITS; s++)
+      for (unsigned hold = dl.remainCards[h][s]; hold; hold &= hold - 1)
+        n++;
+  return n;
+}
+
+
+int TraceTrickWinner(
+  const deal& dl,
+  const int suit,
+  const int rank)
+{
+  // The three cards of the current trick and then suit/rank.
+  int bestSuit = dl.currentTrickSuit[0];
+  int bestRank = dl.currentTrickRank[0];
+  int bestRel = 0;
+
+  for (int k = 1; k < 4; k++)
+  {
+    const int s = (k < 3 ? dl.currentTrickSuit[k] : suit);
+    const int r = (k < 3 ? dl.currentTrickRank[k] : rank);
+
+    if (s == bestSuit)
+    {
+      if (r > bestRank)
+      {
+        bestRank = r;
+        bestRel = k;
+      }
+    }
+    else if (s == dl.trump)
+    {
+      bestSuit = s;
+      bestRank = r;
+      bestRel = k;
+    }
+  }
+
+  const int winner = handId(dl.first, bestRel);
+  return winner;
+}
+
+
+bool TraceMakeCard(
+  deal& dl,
+  const int suit,
+  const int rank)
+{
+  // False if the player does not hold the card. Whether the player
+  // may play it is up to the caller.
+  const int trickCards = TraceTrickCards(dl);
+  const int player = handId(dl.first, trickCards);
+  const unsigned hold = static_cast<unsigned>(bitMapRank[rank] << 2);
+
+  if ((dl.remainCards[player][suit] & hold) == 0)
+    return false;
+
+  dl.remainCards[player][suit] ^= hold;
+
+  if (trickCards == 3)
+  {
+    dl.first = TraceTrickWinner(dl, suit, rank);
+    for (int k = 0; k < 3; k++)
+    {
+      dl.currentTrickSuit[k] = 0;
+      dl.currentTrickRank[k] = 0;
+    }
+  }
+  else
+  {
+    dl.currentTrickSuit[trickCards] = suit;
+    dl.currentTrickRank[trickCards] = rank;
+  }
+  return true;
+}
+
+
+void TraceStart(
+  traceType& tr,
+  const deal& dl)
+{
+  tr.dl = dl;
+  tr.trickCards = TraceTrickCards(dl);
+  tr.player = handId(dl.first, tr.trickCards);
+  tr.tricksLeft = (TraceHandCards(dl) + tr.trickCards + 3) / 4;
+  tr.declarer = 0;
+  tr.startSide = dl.first % 2;
+}
+
+
+bool TracePlay(
+  traceType& tr,
+  const int suit,
+  const int rank)
+{
+  if (! TraceMakeCard(tr.dl, suit, rank))
+    return false;
+
+  if (tr.trickCards == 3)
+  {
+    tr.declarer += (tr.dl.first % 2 == tr.startSide ? 0 : 1);
+    tr.tricksLeft--;
+    tr.trickCards = 0;
+  }
+  else
+    tr.trickCards++;
+
+  tr.player = handId(tr.dl.first, tr.trickCards);
+  return true;
+}
+
+
+int TraceLength(
+  const traceType& tr,
+  const int number)
+{
+  // The number of cards of a trace to play, which is below 0 if the
+  // trace does not get past the current trick. The number of the
+  // trace includes the cards of the current trick, and the last
+  // trick is never played.
+  const int cards = min(number, 4 * (tr.tricksLeft - 1));
+  return cards - tr.trickCards;
+}
+
+
+int TraceTricks(
+  const traceType& tr,
+  const int score)
+{
+  // score is for the side to play.
+  if (tr.player % 2 == tr.startSide)
+    return tr.declarer + tr.tricksLeft - score;
+  else
+    return tr.declarer + score;
+}
+
+
+bool OnlyOneChoice(
+  const deal& dl)
+{
+  // True if all the cards that the player to play may play are
+  // equivalent: They are in one suit, and no card of another hand
+  // or of the current trick lies between them.
+
+  const int trickCards = TraceTrickCards(dl);
+  const int player = handId(dl.first, trickCards);
+  const int leadSuit = (trickCards == 0 ? -1 : dl.currentTrickSuit[0]);
+
+  unsigned trickHolds[DDS_SUITS] = {0, 0, 0, 0};
+  for (int k = 0; k < trickCards; k++)
+    trickHolds[dl.currentTrickSuit[k]] |=
+      static_cast<unsigned>(bitMapRank[dl.currentTrickRank[k]] << 2);
+
+  int from = 0, to = DDS_SUITS;
+  if (leadSuit != -1 && dl.remainCards[player][leadSuit] != 0)
+  {
+    from = leadSuit;
+    to = leadSuit + 1;
+  }
+
+  int choices = 0;
+  for (int s = from; s < to; s++)
+  {
+    const unsigned hold = dl.remainCards[player][s];
+    if (hold == 0)
+      continue;
+
+    unsigned others = trickHolds[s];
+    for (int h = 0; h < DDS_HANDS; h++)
+      if (h != player)
+        others |= dl.remainCards[h][s];
+
+    bool inRun = false;
+    for (int r = 14; r >= 2; r--)
+    {
+      const unsigned bit = static_cast<unsigned>(bitMapRank[r] << 2);
+      if (hold & bit)
+      {
+        if (! inRun)
+          choices++;
+        inRun = true;
+      }
+      else if (others & bit)
+        inRun = false;
+    }
+
+    if (choices > 1)
+      return false;
+  }
+
+  return (choices == 1);
+}
+
 
 int STDCALL AnalysePlayBin(
   deal dl,
@@ -40,6 +283,20 @@ int STDCALL AnalysePlayBin(
 
   ThreadData * thrp = memory.GetPtr(static_cast<unsigned>(thrId));
 
+  return AnalysePlayCommon(thrp, dl, play, solvedp, 0);
+}
+
+
+int AnalysePlayCommon(
+  ThreadData * thrp,
+  deal dl,
+  const playTraceBin& play,
+  solvedPlay * solvedp,
+  const int numKnown)
+{
+  // The first numKnown cards of the trace have their scores in
+  // solvedp already, from a trace that started the same way.
+
   moveType move;
   futureTricks fut;
 
@@ -47,176 +304,131 @@ int STDCALL AnalysePlayBin(
   if (ret != RETURN_NO_FAULT)
     return ret;
 
-  const int numTricks = ((thrp->iniDepth + 3) >> 2) + 1;
-  const int numCardsPlayed = ((48 - thrp->iniDepth) % 4) + 1;
+  traceType tr;
+  TraceStart(tr, dl);
+  const int numPlay = TraceLength(tr, play.number);
 
-  int last_trick = (play.number + 3) / 4;
-  int last_card = ((play.number + 3) % 4) + 1;
-  if (last_trick >= numTricks) 
-  {
-    last_trick = numTricks-1;
-    last_card = 4;
-  }
   solvedp->number = 0;
-
-  solvedp->tricks[0] = (numCardsPlayed % 2 == 1 ? 
-    numTricks - fut.score[0] : fut.score[0]);
-  int hint = solvedp->tricks[0];
-  int hintDir;
-
-  int running_remainder = numTricks;
-  int running_declarer = 0;
-  int running_player = dl.first;
-  int running_side = 1; /* defenders */
-  int start_side = running_player % 2;
+  solvedp->tricks[0] = TraceTricks(tr, fut.score[0]);
+
+  // Most cards in a trace don't change the score, so we only search
+  // when a card might. A card can't if it is equivalent to one that
+  // a search has shown to be optimal, or if the player had no real
+  // choice. The optimal card is one for the player now to play, and
+  // its rank is 0 when none is known.
+  int solved_decl = solvedp->tricks[0];
+  int opt_suit = fut.suit[0];
+  int opt_rank = (fut.cards > 0 ? fut.rank[0] : 0);
+  unsigned opt_equals = static_cast<unsigned>(fut.equals[0]);
 #if DEBUG
   int solved_declarer = solvedp->tricks[0];
-  int initial_par = solved_declarer;
   fout.open("trace.txt", ofstream::out | ofstream::app);
-  fout << "Initial solve: " << initial_par << "\n";
-  fout << "no " << play.number << ", Last trick " << last_trick <<
-    ", last card " << last_card << "\n";
-  fout << setw(5) << "trick" << setw(6) << "card" << 
+  fout << "Initial solve: " << solved_declarer << "\n";
+  fout << "no " << play.number << ", cards " << numPlay << "\n";
+  fout << setw(6) << "card" << 
     setw(6) << "rest" << setw(9) << "declarer" <<
-    setw(7) << "player" << setw(7) << "side" <<
+    setw(7) << "player" <<
     setw(6) << "soln0" << setw(6) << "soln1" << setw(6) << "diff" << "\n";
 #endif
 
-  for (int trick = 1; trick <= last_trick; trick++)
+  for (int i = 0; i < numPlay; i++)
   {
-    int best_card = 0, best_suit = 0, best_player = 0, trump_played = 0;
-    int lc = (trick == last_trick ? last_card : 4);
-
-    bool haveCurrent = (numCardsPlayed > 1 && trick == 1);
-    int offset = 4 * (trick - 1) - (numCardsPlayed - 1);
-
-    for (int card = 1; card <= lc; card++)
-    {
-      int suit, rr;
-      bool usingCurrent = (haveCurrent && card < numCardsPlayed);
-      if (usingCurrent)
-      {
-        suit = dl.currentTrickSuit[card - 1];
-        rr = dl.currentTrickRank[card - 1];
-      }
-      else
-      {
-        suit = play.suit[offset + card - 1];
-        rr = play.rank[offset + card - 1];
-      }
-      unsigned hold = static_cast<unsigned>(bitMapRank[rr] << 2);
+    const int suit = play.suit[i];
+    const int rr = play.rank[i];
+    const unsigned hold = static_cast<unsigned>(bitMapRank[rr] << 2);
+    const int leadSuit = (tr.trickCards == 0 ? -1 :
+      tr.dl.currentTrickSuit[0]);
+
+    bool neutral = false;
+    if (opt_rank != 0 && suit == opt_suit &&
+        (rr == opt_rank || (opt_equals & hold)))
+      neutral = true;
+    else if (leadSuit == -1 || suit == leadSuit ||
+        tr.dl.remainCards[tr.player][leadSuit] == 0)
+      neutral = OnlyOneChoice(tr.dl);
 
-      move.suit = suit;
-      move.rank = rr;
-      move.sequence = rr;
-
-      /* Keep track of the winner of the trick so far */
-      if (card == 1)
-      {
-        best_card = rr;
-        best_suit = suit;
-        best_player = dl.first;
-        trump_played = (suit == dl.trump ? 1 : 0);
-      }
-      else if (suit == dl.trump)
-      {
-        if (! trump_played || rr > best_card)
-        {
-          best_card = rr;
-          best_suit = suit;
-          best_player = running_player;
-          trump_played = 1;
-        }
-      }
-      else if (! trump_played && suit == best_suit && rr > best_card)
-      {
-        best_card = rr;
-        best_player = running_player;
-      }
-
-      if ((dl.remainCards[running_player][suit] & hold) == 0)
-      {
-        if (! usingCurrent)
-        {
 #if DEBUG
-          fout << "ERR Trick " << trick << " card " << card <<
-            " pl " << running_player << ": suit " << suit <<
-            " hold " << hold << "\n";
-          fout.close();
+    int resp_player = tr.player;
 #endif
-          return RETURN_PLAY_FAULT;
-        }
-      }
-      else
-        dl.remainCards[running_player][suit] ^= hold;
 
+    const int leader = tr.dl.first;
+    const bool lastCard = (tr.trickCards == 3);
+    if (! TracePlay(tr, suit, rr))
+    {
 #if DEBUG
-      int resp_player = running_player;
+      fout << "ERR card " << i << " pl " << resp_player << 
+        ": suit " << suit << " hold " << hold << "\n";
+      fout.close();
 #endif
+      return RETURN_PLAY_FAULT;
+    }
 
-      if (card == 4)
-      {
-        running_declarer += (best_player % 2 == start_side ? 0 : 1);
-        running_remainder--;
-
-        if ((dl.first + best_player) % 2 == 0)
-        {
-          hintDir = 0; // Same side leads again; lower bound
-          hint = running_remainder - fut.score[0];
-        }
-        else
-        {
-          hintDir = 1; // Other ("our") side wins trick; upper bound
-          hint = fut.score[0] - 1;
-        }
-
-        dl.first = best_player;
-        running_side = (dl.first % 2 == start_side ? 1 : 0);
-        running_player = dl.first;
-      }
-      else
-      {
-        running_player = (running_player + 1) % 4;
-        running_side = 1 - running_side;
-        hint = running_remainder - fut.score[0];
-        hintDir = 0;
-      }
+    move.suit = suit;
+    move.rank = rr;
+    move.sequence = rr;
 
-      if (usingCurrent)
-        continue;
+    int hint, hintDir;
+    if (lastCard && (leader + tr.dl.first) % 2 != 0)
+    {
+      hintDir = 1; // Other ("our") side wins trick; upper bound
+      hint = fut.score[0] - 1;
+    }
+    else
+    {
+      hintDir = 0; // Lower bound
+      hint = tr.tricksLeft - fut.score[0];
+    }
 
-      if ((ret = AnalyseLaterBoard(thrp, dl.first, &move, hint, 
-        hintDir, &fut))
-          != RETURN_NO_FAULT)
-      {
+    const bool known = (i + 1 <= numKnown);
+    if (known || neutral)
+    {
+      // Known result, so we only move on the position. The score
+      // is for the side now to play, as the search would give it.
+      PlayLaterCard(thrp, &move);
+      if (known)
+        solved_decl = solvedp->tricks[i + 1];
+      else
+        solvedp->tricks[i + 1] = solved_decl;
+      fut.score[0] = solved_decl - tr.declarer;
+      if (tr.player % 2 == tr.startSide)
+        fut.score[0] = tr.tricksLeft - fut.score[0];
+      opt_rank = 0;
+      continue;
+    }
+
+    if ((ret = AnalyseLaterBoard(thrp, tr.dl.first, &move, hint, 
+      hintDir, &fut))
+        != RETURN_NO_FAULT)
+    {
 #if DEBUG
-        fout << "SolveBoard failed, ret " << ret << "\n";
-        fout.close();
+      fout << "SolveBoard failed, ret " << ret << "\n";
+      fout.close();
 #endif
-        return ret;
-      }
+      return ret;
+    }
 
-      int new_solved_decl = running_declarer + (running_side ?
-        running_remainder - fut.score[0] : fut.score[0]);
+    const int new_solved_decl = TraceTricks(tr, fut.score[0]);
+    solvedp->tricks[i + 1] = new_solved_decl;
+    solved_decl = new_solved_decl;
 
-      solvedp->tricks[offset + card] = new_solved_decl;
+    opt_suit = fut.suit[0];
+    opt_rank = (fut.cards > 0 ? fut.rank[0] : 0);
+    opt_equals = static_cast<unsigned>(fut.equals[0]);
 
 #if DEBUG
-      fout << setw(5) << trick << 
-        setw(6) << card << 
-        setw(6) << running_remainder << 
-        setw(9) << running_declarer <<
-        setw(7) << cardHand[resp_player] << 
-        setw(7) << running_side <<
-        setw(6) << solved_declarer << 
-        setw(6) << new_solved_decl << 
-        setw(6) << new_solved_decl - solved_declarer << "\n";
-      solved_declarer = new_solved_decl;
+    fout << setw(6) << i + 1 << 
+      setw(6) << tr.tricksLeft << 
+      setw(9) << tr.declarer <<
+      setw(7) << cardHand[resp_player] << 
+      setw(6) << solved_declarer << 
+      setw(6) << new_solved_decl << 
+      setw(6) << new_solved_decl - solved_declarer << "\n";
+    solved_declarer = new_solved_decl;
 #endif
-
-    }
   }
-  solvedp->number = 4 * last_trick + last_card - 3 - (numCardsPlayed - 1);
+
+  // Below 1 for a trace that does not get past the current trick.
+  solvedp->number = numPlay + 1;
 
 #if DEBUG
   fout.close();
@@ -234,22 +446,85 @@ int STDCALL AnalysePlayPBN(
   deal dl;
   playTraceBin play;
 
-  if (ConvertFromPBN(dlPBN.remainCards, dl.remainCards) !=
+  if (ConvertDealsFromPBN(&dlPBN, 1, &dl, false, nullptr) !=
       RETURN_NO_FAULT)
     return RETURN_PBN_FAULT;
 
-  dl.first = dlPBN.first;
-  dl.trump = dlPBN.trump;
-  for (int i = 0; i <= 2; i++)
+  if (ConvertPlayFromPBN(playPBN, play) != RETURN_NO_FAULT)
+    return RETURN_PLAY_FAULT;
+
+  return AnalysePlayBin(dl, play, solvedp, thrId);
+}
+
+
+int STDCALL AnalysePlayBinParallel(
+  deal dl,
+  playTraceBin play,
+  solvedPlay * solvedp)
+{
+  // Gives the same as AnalysePlayBin, but sooner on several threads.
+  // Each position of the trace only depends on the deal and on the
+  // cards before it, so every position becomes a deal of its own,
+  // and they are all solved as one batch. This takes more work in
+  // total, as the positions no longer help each other in one TT.
+
+  boards bd;
+  traceType trace[MAXNOOFBOARDS];
+
+  // Position 0 is the deal itself.
+  TraceStart(trace[0], dl);
+  const int numPlay = TraceLength(trace[0], play.number);
+
+  for (int i = 0; i < numPlay; i++)
   {
-    dl.currentTrickSuit[i] = dlPBN.currentTrickSuit[i];
-    dl.currentTrickRank[i] = dlPBN.currentTrickRank[i];
+    trace[i + 1] = trace[i];
+    if (! TracePlay(trace[i + 1], play.suit[i], play.rank[i]))
+      return RETURN_PLAY_FAULT;
   }
 
+  const int number = max(numPlay, 0) + 1;
+  bd.noOfBoards = number;
+  for (int b = 0; b < number; b++)
+  {
+    bd.deals[b] = trace[b].dl;
+    bd.target[b] = -1;
+    bd.solutions[b] = 1;
+    bd.mode[b] = 1;
+  }
+
+  solvedBoards solved;
+  int ret = SolveAllBoardsBin(&bd, &solved);
+  if (ret != RETURN_NO_FAULT)
+    return ret;
+
+  for (int b = 0; b < number; b++)
+    solvedp->tricks[b] = TraceTricks(trace[b],
+      solved.solvedBoard[b].score[0]);
+
+  // Counted like AnalysePlayBin does, which differs from number
+  // for an empty trace from a trick in progress.
+  solvedp->number = numPlay + 1;
+
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL AnalysePlayPBNParallel(
+  dealPBN dlPBN,
+  playTracePBN playPBN,
+  solvedPlay * solvedp)
+{
+  deal dl;
+  playTraceBin play;
+
+  if (ConvertDealsFromPBN(&dlPBN, 1, &dl, false, nullptr) !=
+      RETURN_NO_FAULT)
+    return RETURN_PBN_FAULT;
+
   if (ConvertPlayFromPBN(playPBN, play) != RETURN_NO_FAULT)
     return RETURN_PLAY_FAULT;
 
-  return AnalysePlayBin(dl, play, solvedp, thrId);
+  return AnalysePlayBinParallel(dl, play, solvedp);
 }
 
 
@@ -274,20 +549,154 @@ void PlaySingleCommon(paramType &param,
 }
 
 
+bool SamePlayDeal(
+  const deal& dl1,
+  const deal& dl2)
+{
+  if (dl1.trump != dl2.trump || dl1.first != dl2.first)
+    return false;
+
+  for (int h = 0; h < DDS_HANDS; h++)
+    for (int s = 0; s < DDS_SUITS; s++)
+      if (dl1.remainCards[h][s] != dl2.remainCards[h][s])
+        return false;
+
+  for (int k = 0; k < 3; k++)
+    if (dl1.currentTrickSuit[k] != dl2.currentTrickSuit[k] ||
+        dl1.currentTrickRank[k] != dl2.currentTrickRank[k])
+      return false;
+
+  return true;
+}
+
+
+bool PlayBefore(
+  const playTraceBin& play1,
+  const playTraceBin& play2)
+{
+  // Traces in order of their cards, so that the traces sharing a
+  // beginning follow each other.
+
+  const int n = CommonPrefix(play1, play2);
+
+  if (n < play1.number && n < play2.number)
+  {
+    if (play1.suit[n] != play2.suit[n])
+      return (play1.suit[n] < play2.suit[n]);
+    return (play1.rank[n] < play2.rank[n]);
+  }
+  return (play1.number < play2.number);
+}
+
+
+int CommonPrefix(
+  const playTraceBin& play1,
+  const playTraceBin& play2)
+{
+  const int n = min(play1.number, play2.number);
+  int i = 0;
+  while (i < n && play1.suit[i] == play2.suit[i] &&
+      play1.rank[i] == play2.rank[i])
+    i++;
+  return i;
+}
+
+
+void PlayGroupCommon(
+  playparamType& playparam,
+  const int thrId,
+  vector<int>& group)
+{
+  // The traces of a group that belong to the same deal are walked
+  // like a trie: Each trace starts out with the scores of the cards
+  // that it shares with the previous one, so only the cards after
+  // the branching point are searched. As they all run on this
+  // thread, the TT is still warm from the previous trace, too.
+
+  if (group.size() == 1)
+  {
+    PlaySingleCommon(playparam, thrId, group[0]);
+    return;
+  }
+
+  ThreadData * thrp = memory.GetPtr(static_cast<unsigned>(thrId));
+
+  // The first board of the group with the same deal.
+  int dealOf[MAXNOOFBOARDS];
+  for (unsigned i = 0; i < group.size(); i++)
+  {
+    unsigned j = 0;
+    while (! SamePlayDeal(playparam.bop->deals[group[i]], 
+        playparam.bop->deals[group[j]]))
+      j++;
+    dealOf[group[i]] = group[j];
+  }
+
+  stable_sort(group.begin(), group.end(),
+    [&playparam, &dealOf](const int bno1, const int bno2)
+    {
+      if (dealOf[bno1] != dealOf[bno2])
+        return (dealOf[bno1] < dealOf[bno2]);
+      return PlayBefore(playparam.plp->plays[bno1],
+        playparam.plp->plays[bno2]);
+    });
+
+  int prev = -1;
+  for (const int bno : group)
+  {
+    const deal& dl = playparam.bop->deals[bno];
+    const playTraceBin& play = playparam.plp->plays[bno];
+    solvedPlay solved;
+    int numKnown = 0;
+
+    if (prev != -1 && SamePlayDeal(dl, playparam.bop->deals[prev]))
+    {
+      solved = playparam.solvedplays->solved[prev];
+      numKnown = min(CommonPrefix(play, playparam.plp->plays[prev]),
+        solved.number);
+    }
+
+    int res = AnalysePlayCommon(thrp, dl, play, &solved, numKnown);
+
+    if (res == RETURN_NO_FAULT)
+    {
+      playparam.solvedplays->solved[bno] = solved;
+      prev = bno;
+    }
+    else
+    {
+      playparam.error = res;
+      prev = -1;
+    }
+  }
+}
+
+
 void PlayChunkCommon(paramType &param, const int thrId,
     Scheduler &scheduler)
 {
-  int index;
+  // A thread gets all the boards of a group one after the other,
+  // and the group head comes first. The boards of a group are
+  // collected and analysed together.
+
+  playparamType &playparam = static_cast<playparamType&>(param);
+  vector<int> group;
   schedType st;
 
   while (1)
   {
     st = scheduler.GetNumber(thrId);
-    index = st.number;
-    if (index == -1)
+
+    if (! group.empty() && (st.number == -1 || st.repeatOf == -1))
+    {
+      PlayGroupCommon(playparam, thrId, group);
+      group.clear();
+    }
+
+    if (st.number == -1)
       break;
 
-    PlaySingleCommon(param, thrId, index);
+    group.push_back(st.number);
   }
 }
 
@@ -341,24 +750,9 @@ int STDCALL AnalyseAllPlaysPBN(
   if (bd.noOfBoards > MAXNOOFBOARDS)
     return RETURN_TOO_MANY_BOARDS;
 
-  for (int k = 0; k < bopPBN->noOfBoards; k++)
-  {
-    deal& dl = bd.deals[k];
-    dealPBN& dlp = bopPBN->deals[k];
-
-    if (ConvertFromPBN(dlp.remainCards,
-                       dl.remainCards) != RETURN_NO_FAULT)
-      return RETURN_PBN_FAULT;
-
-    dl.trump = dlp.trump;
-    dl.first = dlp.first;
-
-    for (int i = 0; i <= 2; i++)
-    {
-      dl.currentTrickSuit[i] = dlp.currentTrickSuit[i];
-      dl.currentTrickRank[i] = dlp.currentTrickRank[i];
-    }
-  }
+  if (ConvertDealsFromPBN(bopPBN->deals, bopPBN->noOfBoards, bd.deals,
+      false, nullptr) != RETURN_NO_FAULT)
+    return RETURN_PBN_FAULT;
 
   pl.noOfBoards = plpPBN->noOfBoards;
 
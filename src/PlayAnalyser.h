@@ -18,6 +18,48 @@ using namespace std;
 
 class Scheduler;
 
+// A deal followed card by card through a play trace. dl is the
+// position, with the cards of the current trick. declarer counts
+// the tricks won by the side that was not on lead at the start.
+
+struct traceType
+{
+  deal dl;
+  int trickCards;
+  int player;
+  int tricksLeft;
+  int declarer;
+  int startSide;
+};
+
+int TraceTrickCards(
+  const deal& dl);
+
+int TraceHandCards(
+  const deal& dl);
+
+bool TraceMakeCard(
+  deal& dl,
+  const int suit,
+  const int rank);
+
+void TraceStart(
+  traceType& tr,
+  const deal& dl);
+
+bool TracePlay(
+  traceType& tr,
+  const int suit,
+  const int rank);
+
+int TraceLength(
+  const traceType& tr,
+  const int number);
+
+int TraceTricks(
+  const traceType& tr,
+  const int score);
+
 void PlaySingleCommon(paramType &param,
   const int thrId,
   const int bno);
@@ -81,6 +81,7 @@ int QuickTricksPartnerHandNT(
   const ThreadData& thrd);
 
 
+template <class Strain>
 int QuickTricks(
   pos& tpos,
   const int hand,
@@ -110,7 +111,7 @@ int QuickTricks(
 
   for (int s = 0; s < DDS_SUITS; s++)
   {
-    if ((trump != DDS_NOTRUMP) && (trump != s))
+    if (Strain::hasTrump && (trump != s))
     {
       /* Trump game, and we lead a non-trump suit */
       if (winner[s].hand == partner[hand])
@@ -146,7 +147,7 @@ int QuickTricks(
         }
       }
     }
-    else if (trump == DDS_NOTRUMP)
+    else if (! Strain::hasTrump)
     {
       if (winner[s].hand == partner[hand])
       {
@@ -173,7 +174,7 @@ int QuickTricks(
     }
   }
 
-  if ((trump != DDS_NOTRUMP) && (!commPartner) &&
+  if (Strain::hasTrump && (!commPartner) &&
       (ris[hand][trump] != 0) &&
       (winner[trump].hand == partner[hand]))
   {
@@ -183,7 +184,7 @@ int QuickTricks(
     commRank = winner[trump].rank;
   }
 
-  if (trump != DDS_NOTRUMP)
+  if (Strain::hasTrump)
   {
     suit = trump;
     lhoTrumpRanks = len[lho[hand]][trump];
@@ -205,15 +206,15 @@ int QuickTricks(
       if (countOwn == 0)
       {
         /* Continue with next suit. */
-        if ((trump != DDS_NOTRUMP) && (trump != suit))
+        if (Strain::hasTrump && (trump != suit))
         {
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
         }
         else
         {
-          if ((trump != DDS_NOTRUMP) && (trump == suit))
+          if (Strain::hasTrump && (trump == suit))
           {
             if (trump == 0)
               suit = 1;
@@ -227,7 +228,7 @@ int QuickTricks(
       }
 
       /* Long tricks when only leading hand have cards in the suit. */
-      if ((trump != DDS_NOTRUMP) && (trump != suit))
+      if (Strain::hasTrump && (trump != suit))
       {
         if ((lhoTrumpRanks == 0) && (rhoTrumpRanks == 0))
         {
@@ -235,14 +236,14 @@ int QuickTricks(
           if (qtricks >= cutoff)
             return qtricks;
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
           continue;
         }
         else
         {
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
           continue;
         }
@@ -253,7 +254,7 @@ int QuickTricks(
         if (qtricks >= cutoff)
           return qtricks;
 
-        if ((trump != DDS_NOTRUMP) && (suit == trump))
+        if (Strain::hasTrump && (suit == trump))
         {
           if (trump == 0)
             suit = 1;
@@ -263,7 +264,7 @@ int QuickTricks(
         else
         {
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
         }
         continue;
@@ -271,7 +272,7 @@ int QuickTricks(
     }
     else
     {
-      if (!opps && (trump != DDS_NOTRUMP) && (suit == trump))
+      if (!opps && Strain::hasTrump && (suit == trump))
       {
         /* The partner but not the opponents have cards in
            the trump suit. */
@@ -298,7 +299,7 @@ int QuickTricks(
       {
         /* The partner but not the opponents have cards in the suit. */
         int sum = min(countOwn, countPart);
-        if (trump == DDS_NOTRUMP)
+        if (! Strain::hasTrump)
         {
           if (sum >= cutoff)
             return sum;
@@ -316,7 +317,7 @@ int QuickTricks(
       {
         if (!opps && (countOwn == 0))
         {
-          if ((trump != DDS_NOTRUMP) && (trump != suit))
+          if (Strain::hasTrump && (trump != suit))
           {
             if ((lhoTrumpRanks == 0) && (rhoTrumpRanks == 0))
             {
@@ -328,14 +329,14 @@ int QuickTricks(
                 return qtricks;
 
               suit++;
-              if ((trump != DDS_NOTRUMP) && (suit == trump))
+              if (Strain::hasTrump && (suit == trump))
                 suit++;
               continue;
             }
             else
             {
               suit++;
-              if ((trump != DDS_NOTRUMP) && (suit == trump))
+              if (Strain::hasTrump && (suit == trump))
                 suit++;
               continue;
             }
@@ -349,7 +350,7 @@ int QuickTricks(
             if (qtricks >= cutoff)
               return qtricks;
 
-            if ((trump != DDS_NOTRUMP) && (suit == trump))
+            if (Strain::hasTrump && (suit == trump))
             {
               if (trump == 0)
                 suit = 1;
@@ -359,7 +360,7 @@ int QuickTricks(
             else
             {
               suit++;
-              if ((trump != DDS_NOTRUMP) && (suit == trump))
+              if (Strain::hasTrump && (suit == trump))
                 suit++;
             }
             continue;
@@ -367,7 +368,7 @@ int QuickTricks(
         }
         else
         {
-          if (!opps && (trump != DDS_NOTRUMP) && (suit == trump))
+          if (!opps && Strain::hasTrump && (suit == trump))
           {
             int sum = max(countOwn, countPart);
             for (int s = 0; s < DDS_SUITS; s++)
@@ -392,7 +393,7 @@ int QuickTricks(
           else if (!opps)
           {
             int sum = min(countOwn, countPart);
-            if (trump == DDS_NOTRUMP)
+            if (! Strain::hasTrump)
             {
               if (sum >= cutoff)
                 return sum;
@@ -411,7 +412,7 @@ int QuickTricks(
 
     if (winner[suit].rank == 0)
     {
-      if ((trump != DDS_NOTRUMP) && (suit == trump))
+      if (Strain::hasTrump && (suit == trump))
       {
         if (trump == 0)
           suit = 1;
@@ -421,7 +422,7 @@ int QuickTricks(
       else
       {
         suit++;
-        if ((trump != DDS_NOTRUMP) && (suit == trump))
+        if (Strain::hasTrump && (suit == trump))
           suit++;
       }
       continue;
@@ -429,7 +430,7 @@ int QuickTricks(
 
     if (winner[suit].hand == hand)
     {
-      if ((trump != DDS_NOTRUMP) && (trump != suit))
+      if (Strain::hasTrump && (trump != suit))
       {
         qtricks = QtricksLeadHandTrump(hand, tpos, cutoff, depth,
           countLho, countRho, lhoTrumpRanks, rhoTrumpRanks,
@@ -440,7 +441,7 @@ int QuickTricks(
         else if (res == 2)
         {
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
           continue;
         }
@@ -456,7 +457,7 @@ int QuickTricks(
           return qtricks;
         else if (res == 2)
         {
-          if ((trump != DDS_NOTRUMP) && (trump == suit))
+          if (Strain::hasTrump && (trump == suit))
           {
             if (trump == 0)
               suit = 1;
@@ -481,7 +482,7 @@ int QuickTricks(
         if (commPartner)
         {
           /* There is communication with the partner */
-          if ((trump != DDS_NOTRUMP) && (trump != suit))
+          if (Strain::hasTrump && (trump != suit))
           {
             qtricks = QuickTricksPartnerHandTrump(hand, tpos,
               cutoff, depth, countLho, countRho,
@@ -493,7 +494,7 @@ int QuickTricks(
             else if (res == 2)
             {
               suit++;
-              if ((trump != DDS_NOTRUMP) && (suit == trump))
+              if (Strain::hasTrump && (suit == trump))
                 suit++;
               continue;
             }
@@ -508,7 +509,7 @@ int QuickTricks(
               return qtricks;
             else if (res == 2)
             {
-              if ((trump != DDS_NOTRUMP) && (trump == suit))
+              if (Strain::hasTrump && (trump == suit))
               {
                 if (trump == 0)
                   suit = 1;
@@ -523,7 +524,7 @@ int QuickTricks(
         }
       }
     }
-    if ((trump != DDS_NOTRUMP) && (suit != trump) &&
+    if (Strain::hasTrump && (suit != trump) &&
         (countOwn > 0) && (lowestQtricks == 0) &&
         ((qtricks == 0) ||
          ((winner[suit].hand != hand) &&
@@ -540,7 +541,7 @@ int QuickTricks(
           if (1 >= cutoff)
             return 1;
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
           continue;
         }
@@ -561,7 +562,7 @@ int QuickTricks(
             }
           }
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
           continue;
         }
@@ -583,7 +584,7 @@ int QuickTricks(
               return 1;
           }
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
           continue;
         }
@@ -605,7 +606,7 @@ int QuickTricks(
               return 1;
           }
           suit++;
-          if ((trump != DDS_NOTRUMP) && (suit == trump))
+          if (Strain::hasTrump && (suit == trump))
             suit++;
           continue;
         }
@@ -615,7 +616,7 @@ int QuickTricks(
     if (qtricks >= cutoff)
       return qtricks;
 
-    if ((trump != DDS_NOTRUMP) && (suit == trump))
+    if (Strain::hasTrump && (suit == trump))
     {
       if (trump == 0)
         suit = 1;
@@ -625,7 +626,7 @@ int QuickTricks(
     else
     {
       suit++;
-      if ((trump != DDS_NOTRUMP) && (suit == trump))
+      if (Strain::hasTrump && (suit == trump))
         suit++;
     }
   }
@@ -633,7 +634,7 @@ int QuickTricks(
 
   if (qtricks == 0)
   {
-    if ((trump == DDS_NOTRUMP) || (winner[trump].hand == -1))
+    if ((! Strain::hasTrump) || (winner[trump].hand == -1))
     {
       for (int ss = 0; ss < DDS_SUITS; ss++)
       {
@@ -1095,6 +1096,7 @@ int QuickTricksPartnerHandNT(
 }
 
 
+template <class Strain>
 bool QuickTricksSecondHand(
   pos& tpos,
   const int hand,
@@ -1114,7 +1116,7 @@ bool QuickTricksSecondHand(
   for (int s = 0; s < DDS_SUITS; s++)
     tpos.winRanks[depth][s] = 0;
 
-  if ((trump != DDS_NOTRUMP) && (ss != trump) &&
+  if (Strain::hasTrump && (ss != trump) &&
       (((ris[hand][ss] == 0) && (ris[hand][trump] != 0)) ||
        ((ris[partner[hand]][ss] == 0) &&
         (ris[partner[hand]][trump] != 0))))
@@ -1129,7 +1131,7 @@ bool QuickTricksSecondHand(
   else if (ranks > (bitMapRank[tpos.move[depth + 1].rank] |
                     ris[lho[hand]][ss]))
   {
-    if ((trump != DDS_NOTRUMP) && (ss != trump) &&
+    if (Strain::hasTrump && (ss != trump) &&
         (ris[lho[hand]][trump] != 0) &&
         (ris[lho[hand]][ss] == 0))
       return false;
@@ -1156,7 +1158,7 @@ bool QuickTricksSecondHand(
   if (qtricks >= cutoff)
     return true;
 
-  if (trump != DDS_NOTRUMP)
+  if (Strain::hasTrump)
     return false;
 
   /* In NT, second winner (by rank) in same suit. */
@@ -1209,3 +1211,37 @@ bool QuickTricksSecondHand(
   return false;
 }
 
+
+template int QuickTricks<StrainNT>(
+  pos& tpos,
+  const int hand,
+  const int depth,
+  const int target,
+  const int trump,
+  bool& result,
+  const ThreadData& thrd);
+
+template int QuickTricks<StrainSuit>(
+  pos& tpos,
+  const int hand,
+  const int depth,
+  const int target,
+  const int trump,
+  bool& result,
+  const ThreadData& thrd);
+
+template bool QuickTricksSecondHand<StrainNT>(
+  pos& tpos,
+  const int hand,
+  const int depth,
+  const int target,
+  const int trump,
+  const ThreadData& thrd);
+
+template bool QuickTricksSecondHand<StrainSuit>(
+  pos& tpos,
+  const int hand,
+  const int depth,
+  const int target,
+  const int trump,
+  const ThreadData& thrd);
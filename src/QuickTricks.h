@@ -14,6 +14,7 @@
 #include "Memory.h"
 
 
+template <class Strain>
 int QuickTricks(
   pos& tpos,
   const int hand,
@@ -23,6 +24,7 @@ int QuickTricks(
   bool& result,
   const ThreadData& thrd);
 
+template <class Strain>
 bool QuickTricksSecondHand(
   pos& tpos,
   const int hand,
@@ -14,6 +14,7 @@
 #include <math.h>
 
 #include "Scheduler.h"
+#include "Canonical.h"
 
 
 Scheduler::Scheduler(
@@ -173,29 +174,36 @@ void Scheduler::MakeGroups(const boards& bds)
   {
     dl = &bds.deals[b];
 
-    int strain = dl->trump;
+    // Boards are grouped by their canonical form, so a group also
+    // collects boards with permuted suits or rotated seats.
+    // The strain of the canonical form is just suit or NT.
+
+    MakeCanonical(* dl, hands[b].canon);
+    deal const * cdl = &hands[b].canon.dl;
+
+    int strain = cdl->trump;
 
     unsigned dlXor =
-      dl->remainCards[0][0] ^
-      dl->remainCards[1][1] ^
-      dl->remainCards[2][2] ^
-      dl->remainCards[3][3];
+      cdl->remainCards[0][0] ^
+      cdl->remainCards[1][1] ^
+      cdl->remainCards[2][2] ^
+      cdl->remainCards[3][3];
 
     int key = static_cast<int>(((dlXor >> 2) ^ (dlXor >> 6)) & 0x7f);
 
     hands[b].spareKey = static_cast<int>(
-                          (dl->remainCards[1][0] << 17) ^
-                          (dl->remainCards[2][1] << 11) ^
-                          (dl->remainCards[3][2] << 5) ^
-                          (dl->remainCards[0][3] >> 2));
+                          (cdl->remainCards[1][0] << 17) ^
+                          (cdl->remainCards[2][1] << 11) ^
+                          (cdl->remainCards[3][2] << 5) ^
+                          (cdl->remainCards[0][3] >> 2));
 
     for (int h = 0; h < DDS_HANDS; h++)
       for (int s = 0; s < DDS_SUITS; s++)
         hands[b].remainCards[h][s] = dl->remainCards[h][s];
 
     hands[b].NTflag = (strain == 4 ? 1 : 0);
-    hands[b].first = dl->first;
-    hands[b].strain = strain;
+    hands[b].first = cdl->first;
+    hands[b].strain = dl->trump;
     hands[b].fanout = Scheduler::Fanout(* dl);
 #ifdef DDS_SCHEDULER
     hands[b].strength = Scheduler::Strength(* dl);
@@ -254,11 +262,7 @@ void Scheduler::FinetuneGroups()
       {
         // It is now extremely likely that it is a repeat hand,
         // but we have to be sure.
-        match = true;
-        for (int h = 0; h < DDS_HANDS && match; h++)
-          for (int s = 0; s < DDS_SUITS && match; s++)
-            if (hands[b1].remainCards[h][s] != hands[b2].remainCards[h][s])
-              match = false;
+        match = SameCanonicalCards(hands[b1].canon, hands[b2].canon);
       }
 
       if (match)
@@ -320,7 +324,8 @@ void Scheduler::FinetuneGroups()
 
       int l = 0;
       while (l < sortLen-1 && 
-        Scheduler::SameHand(sortList[l].number, sortList[l+1].number))
+        SameCanonicalCards(hands[sortList[l].number].canon,
+          hands[sortList[l+1].number].canon))
         l++;
 
       if (l == sortLen-1)
@@ -345,7 +350,8 @@ void Scheduler::FinetuneGroups()
 
       while (l < sortLen)
       {
-        if (Scheduler::SameHand(sortList[l].number, sortList[l-1].number))
+        if (SameCanonicalCards(hands[sortList[l].number].canon,
+            hands[sortList[l-1].number].canon))
         {
           // Same group
           int nOld = sortList[l - 1].number;
@@ -380,6 +386,17 @@ void Scheduler::FinetuneGroups()
 }
 
 
+void Scheduler::MapRepeat(schedType& st) const
+{
+  // Both boards have the same canonical cards. Go from the
+  // original board to the canonical one and back to this one.
+  const dealCanonical& cOrig = hands[st.repeatOf].canon;
+  const dealCanonical& cThis = hands[st.number].canon;
+
+  st.rotation = (cOrig.rotation + cThis.rotation) & 3;
+}
+
+
 bool Scheduler::SameHand(
   const int hno1,
   const int hno2) const
@@ -768,6 +785,7 @@ schedType Scheduler::GetNumber(const int thrId)
   else
   {
     st.repeatOf = group[g].head;
+    Scheduler::MapRepeat(st);
     //hands[st.number].selectFlag = 0;
 
     if (hands[st.number].first == hands[st.repeatOf].first)
@@ -37,6 +37,10 @@ struct schedType
 {
   int number;
   int repeatOf;
+
+  // For a repeat, how the results of repeatOf carry over: Its seat
+  // h is seat (h + rotation) & 3 here.
+  int rotation;
 };
 
 
@@ -72,6 +76,7 @@ class Scheduler
       int next;
       int spareKey;
       unsigned remainCards[DDS_HANDS][DDS_SUITS];
+      dealCanonical canon;
       int NTflag;
       int first;
       int strain;
@@ -122,6 +127,8 @@ class Scheduler
       const int hno1,
       const int hno2) const;
 
+    void MapRepeat(schedType& st) const;
+
     void SortSolve(),
          SortCalc(),
          SortTrace();
@@ -0,0 +1,492 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+/*
+   A game session follows one deal card by card on one thread.
+   Each card is made in the position that the search keeps in the
+   thread, as the PlayAnalyser does, so the moves and the TT carry
+   over from one card to the next. If something else was solved on
+   the thread in between, the session sets up its position again.
+   The last trick is solved without setting up the search, so once
+   it is reached the thread no longer follows the session.
+
+   While the client waits for the next card, a session can solve
+   the positions after the likely next cards on a worker of its own.
+   The worker has spare thread data, so the thread itself stays free
+   and keeps its position. A card that was solved ahead is answered
+   at once and only played into that position. For any other card
+   the worker is told to stop, but nobody waits for it. A solve that
+   has started runs to its end, as the search has no way to stop
+   early. So the worker only moves on to the next run after that,
+   and turning speculation off waits for it as well.
+
+   GetOptimalLine plays a deal out the same way, always with the
+   first optimal card.
+*/
+
+
+#include <algorithm>
+
+#include "SolverIF.h"
+#include "System.h"
+#include "PBN.h"
+#include "PlayAnalyser.h"
+
+extern System sysdep;
+extern Memory memory;
+
+int SessionPlay(
+  deal& dl,
+  const int suit,
+  const int rank,
+  const int score);
+
+void SessionStartRun(
+  ThreadData * thrp);
+
+void SessionStopRun(
+  ThreadData * thrp);
+
+void SessionSpeculate(
+  SessionWorkerType * worker);
+
+
+SessionWorkerType::~SessionWorkerType()
+{
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    quit = true;
+    stop = true;
+  }
+  cv.notify_one();
+
+  if (thread.joinable())
+    thread.join();
+}
+
+
+void SessionStopRun(
+  ThreadData * thrp)
+{
+  // The results of the run so far are no longer needed either.
+  thrp->sessionRun.reset();
+
+  SessionWorkerType * worker = thrp->sessionWorker.get();
+  if (worker == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> lock(worker->mtx);
+  worker->next.reset();
+  worker->stop = true;
+}
+
+
+int SessionPlay(
+  deal& dl,
+  const int suit,
+  const int rank,
+  const int score)
+{
+  // Makes the card. score is what the side that plays it could take
+  // before, and it keeps that when the card is optimal. Returns the
+  // score of the side to play next in that case, which makes a good
+  // guess for the new position.
+
+  const int trickCards = TraceTrickCards(dl);
+  const int player = handId(dl.first, trickCards);
+  int tricksLeft = (TraceHandCards(dl) + trickCards + 3) / 4;
+  int sideTricks = score;
+
+  TraceMakeCard(dl, suit, rank);
+
+  if (trickCards == 3)
+  {
+    if ((dl.first & 1) == (player & 1))
+      sideTricks--;
+    tricksLeft--;
+  }
+
+  const int nextPlayer = handId(dl.first, TraceTrickCards(dl));
+  const int guess = ((nextPlayer & 1) == (player & 1) ?
+    sideTricks : tricksLeft - sideTricks);
+  return guess;
+}
+
+
+void SessionStartRun(
+  ThreadData * thrp)
+{
+  // Picks the likely next cards: the optimal card, the cards that
+  // are equivalent to it, and then the other legal cards from the
+  // top down. The worker solves them in that order.
+
+  const deal& dl = thrp->sessionDeal;
+  const int trickCards = TraceTrickCards(dl);
+  const int player = handId(dl.first, trickCards);
+
+  unsigned legal[DDS_SUITS];
+  for (int s = 0; s < DDS_SUITS; s++)
+    legal[s] = dl.remainCards[player][s];
+  if (trickCards > 0 && legal[dl.currentTrickSuit[0]] != 0)
+  {
+    for (int s = 0; s < DDS_SUITS; s++)
+      if (s != dl.currentTrickSuit[0])
+        legal[s] = 0;
+  }
+
+  std::shared_ptr<SessionRunType> run(new SessionRunType);
+  run->dl = dl;
+  run->number = 0;
+  run->done = 0;
+
+  const int maxCards = min(thrp->sessionSpecCards, 13);
+  const futureTricks& fut = thrp->sessionFut;
+
+  if (fut.cards > 0 && fut.rank[0] != 0)
+  {
+    const int s = fut.suit[0];
+    const unsigned seq = static_cast<unsigned>(
+      (bitMapRank[fut.rank[0]] << 2) | fut.equals[0]);
+
+    for (int r = 14; r >= 2 && run->number < maxCards; r--)
+    {
+      const unsigned hold = static_cast<unsigned>(bitMapRank[r] << 2);
+      if ((seq & legal[s] & hold) == 0)
+        continue;
+
+      // The optimal card itself goes first.
+      const int n = (r == fut.rank[0] ? 0 : run->number);
+      if (n != run->number)
+      {
+        run->suit[run->number] = run->suit[0];
+        run->rank[run->number] = run->rank[0];
+      }
+      run->suit[n] = s;
+      run->rank[n] = r;
+      run->number++;
+      legal[s] ^= hold;
+    }
+  }
+
+  for (int s = 0; s < DDS_SUITS; s++)
+  {
+    for (int r = 14; r >= 2 && run->number < maxCards; r--)
+    {
+      if ((legal[s] & static_cast<unsigned>(bitMapRank[r] << 2)) == 0)
+        continue;
+
+      run->suit[run->number] = s;
+      run->rank[run->number] = r;
+      run->number++;
+    }
+  }
+
+  if (! thrp->sessionWorker)
+  {
+    std::unique_ptr<SessionWorkerType> worker(new SessionWorkerType);
+    worker->data = memory.MakeSpare();
+    worker->quit = false;
+    worker->stop = false;
+    worker->thread = std::thread(SessionSpeculate, worker.get());
+    thrp->sessionWorker = std::move(worker);
+  }
+
+  // The old run is of no use any more.
+  SessionWorkerType * worker = thrp->sessionWorker.get();
+  {
+    std::lock_guard<std::mutex> lock(worker->mtx);
+    worker->next = run;
+    worker->stop = true;
+  }
+  worker->cv.notify_one();
+
+  thrp->sessionRun = std::move(run);
+}
+
+
+void SessionSpeculate(
+  SessionWorkerType * worker)
+{
+  while (true)
+  {
+    std::shared_ptr<SessionRunType> run;
+    {
+      std::unique_lock<std::mutex> lock(worker->mtx);
+      worker->cv.wait(lock,
+        [worker] { return worker->quit || worker->next != nullptr; });
+      if (worker->quit)
+        return;
+
+      run = std::move(worker->next);
+      worker->stop = false;
+    }
+
+    for (int n = 0; n < run->number; n++)
+    {
+      if (worker->stop)
+        break;
+
+      deal next = run->dl;
+      TraceMakeCard(next, run->suit[n], run->rank[n]);
+
+      futureTricks& fut = run->fut[n];
+      if (TraceHandCards(next) == 0)
+      {
+        fut.nodes = 0;
+        fut.cards = 0;
+        fut.score[0] = 0;
+      }
+      else if (SolveBoardInternal(worker->data.get(), next, -1, 1, 1,
+          &fut) != RETURN_NO_FAULT)
+        break;
+
+      run->done.store(n + 1, std::memory_order_release);
+    }
+  }
+}
+
+
+int STDCALL StartSession(
+  deal dl,
+  int thrId,
+  futureTricks * futp)
+{
+  if (! sysdep.ThreadOK(thrId))
+    return RETURN_THREAD_INDEX;
+
+  ThreadData * thrp = memory.GetPtr(static_cast<unsigned>(thrId));
+  thrp->sessionFlag = false;
+  SessionStopRun(thrp);
+
+  int ret = SolveBoardInternal(thrp, dl, -1, 1, 1, futp);
+  if (ret != RETURN_NO_FAULT)
+    return ret;
+
+  thrp->sessionFlag = true;
+  thrp->sessionSynced = (TraceHandCards(dl) > 4);
+  thrp->sessionDeal = dl;
+  thrp->sessionFut = * futp;
+
+  if (thrp->sessionSpecCards > 0)
+    SessionStartRun(thrp);
+
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL StartSessionPBN(
+  dealPBN dlPBN,
+  int thrId,
+  futureTricks * futp)
+{
+  deal dl;
+  if (ConvertDealsFromPBN(&dlPBN, 1, &dl, false, nullptr) !=
+      RETURN_NO_FAULT)
+    return RETURN_PBN_FAULT;
+
+  return StartSession(dl, thrId, futp);
+}
+
+
+int STDCALL SetSessionSpeculation(
+  int cards,
+  int thrId)
+{
+  if (! sysdep.ThreadOK(thrId))
+    return RETURN_THREAD_INDEX;
+
+  ThreadData * thrp = memory.GetPtr(static_cast<unsigned>(thrId));
+  thrp->sessionSpecCards = max(cards, 0);
+
+  if (thrp->sessionSpecCards == 0)
+  {
+    // Also gives back the spare data.
+    thrp->sessionWorker.reset();
+    thrp->sessionRun.reset();
+  }
+  else if (! thrp->sessionFlag)
+    SessionStopRun(thrp);
+  else
+    SessionStartRun(thrp);
+
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL SessionPlayCard(
+  int suit,
+  int rank,
+  int thrId,
+  futureTricks * futp)
+{
+  if (! sysdep.ThreadOK(thrId))
+    return RETURN_THREAD_INDEX;
+
+  ThreadData * thrp = memory.GetPtr(static_cast<unsigned>(thrId));
+  if (! thrp->sessionFlag)
+    return RETURN_NO_SESSION;
+
+  if (suit < 0 || suit >= DDS_SUITS || rank < 2 || rank > 14)
+    return RETURN_SUIT_OR_RANK;
+
+  deal& dl = thrp->sessionDeal;
+  const int trickCards = TraceTrickCards(dl);
+  const int player = handId(dl.first, trickCards);
+  const unsigned hold = static_cast<unsigned>(bitMapRank[rank] << 2);
+
+  if ((dl.remainCards[player][suit] & hold) == 0)
+    return RETURN_PLAY_FAULT;
+
+  if (trickCards > 0 && suit != dl.currentTrickSuit[0] &&
+      dl.remainCards[player][dl.currentTrickSuit[0]] != 0)
+    return RETURN_PLAY_FAULT;
+
+  const int guess = SessionPlay(dl, suit, rank, thrp->sessionFut.score[0]);
+
+  const int handCards = TraceHandCards(dl);
+  if (handCards == 0)
+  {
+    // That was the last card.
+    SessionStopRun(thrp);
+    thrp->sessionFlag = false;
+    futp->nodes = 0;
+    futp->cards = 0;
+    futp->score[0] = 0;
+    return RETURN_NO_FAULT;
+  }
+
+  // Was the card solved ahead?
+  SessionRunType const * run = thrp->sessionRun.get();
+  if (run != nullptr)
+  {
+    const int done = run->done.load(std::memory_order_acquire);
+    for (int n = 0; n < done; n++)
+    {
+      if (run->suit[n] != suit || run->rank[n] != rank)
+        continue;
+
+      // The thread only has to follow the card.
+      if (thrp->sessionSynced && handCards > 4)
+      {
+        moveType move;
+        move.suit = suit;
+        move.rank = rank;
+        move.sequence = rank;
+        PlayLaterCard(thrp, &move);
+      }
+      else
+        thrp->sessionSynced = false;
+
+      * futp = run->fut[n];
+      thrp->sessionFut = * futp;
+      SessionStartRun(thrp);
+      return RETURN_NO_FAULT;
+    }
+
+    SessionStopRun(thrp);
+  }
+
+  int ret;
+  if (thrp->sessionSynced && handCards > 4)
+  {
+    moveType move;
+    move.suit = suit;
+    move.rank = rank;
+    move.sequence = rank;
+
+    ret = SolveLaterBoard(thrp, dl.first, &move, guess, 1, futp);
+  }
+  else
+  {
+    ret = SolveBoardInternal(thrp, dl, -1, 1, 1, futp);
+    thrp->sessionSynced = (handCards > 4);
+  }
+
+  if (ret != RETURN_NO_FAULT)
+  {
+    thrp->sessionFlag = false;
+    return ret;
+  }
+
+  thrp->sessionFut = * futp;
+
+  if (thrp->sessionSpecCards > 0)
+    SessionStartRun(thrp);
+
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL GetOptimalLine(
+  deal dl,
+  int thrId,
+  optimalLine * linep)
+{
+  if (! sysdep.ThreadOK(thrId))
+    return RETURN_THREAD_INDEX;
+
+  ThreadData * thrp = memory.GetPtr(static_cast<unsigned>(thrId));
+  thrp->sessionFlag = false;
+  SessionStopRun(thrp);
+
+  linep->number = 0;
+
+  int ret = SolveBoardInternal(thrp, dl, -1, 2, 1, &linep->fut[0]);
+  if (ret != RETURN_NO_FAULT)
+    return ret;
+
+  int handCards = TraceHandCards(dl);
+  bool synced = (handCards > 4);
+  int n = 0;
+
+  while (true)
+  {
+    futureTricks const * futp = &linep->fut[n];
+    linep->number = ++n;
+
+    moveType move;
+    move.suit = futp->suit[0];
+    move.rank = futp->rank[0];
+    move.sequence = move.rank;
+
+    const int guess = SessionPlay(dl, move.suit, move.rank,
+      futp->score[0]);
+
+    if (--handCards == 0)
+      break;
+
+    if (synced && handCards > 4)
+      ret = SolveLaterBoard(thrp, dl.first, &move, guess, 2,
+        &linep->fut[n]);
+    else
+    {
+      ret = SolveBoardInternal(thrp, dl, -1, 2, 1, &linep->fut[n]);
+      synced = (handCards > 4);
+    }
+
+    if (ret != RETURN_NO_FAULT)
+      return ret;
+  }
+
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL GetOptimalLinePBN(
+  dealPBN dlPBN,
+  int thrId,
+  optimalLine * linep)
+{
+  deal dl;
+  if (ConvertDealsFromPBN(&dlPBN, 1, &dl, false, nullptr) !=
+      RETURN_NO_FAULT)
+    return RETURN_PBN_FAULT;
+
+  return GetOptimalLine(dl, thrId, linep);
+}
@@ -14,11 +14,13 @@
 #include "Memory.h"
 #include "Scheduler.h"
 #include "PBN.h"
+#include "DealFile.h"
 #include "debug.h"
 
 
 extern System sysdep;
 extern Memory memory;
+extern DealFile dealFile;
 
 int SolveAllBoardsN(
   boards& bds,
@@ -86,10 +88,13 @@ void SolveChunkCommon(paramType &param,
     // a group might have declarers N, S, N, N. Then the second
     // N would not reuse the first N. However, must reuses are
     // reasonably adjacent, and this is just an optimization anyway.
+    // A group also holds boards with permuted suits or rotated seats.
+    // Their solutions are not reused, as the order of cards of equal
+    // score would then depend on which board of the group came first.
 
     if (st.repeatOf != -1 &&
-        param.bop->deals[index ].first ==
-        param.bop->deals[st.repeatOf].first)
+        SameBoard(* param.bop, static_cast<unsigned>(index),
+          static_cast<unsigned>(st.repeatOf)))
     {
       START_THREAD_TIMER(thrId);
       param.solvedp->solvedBoard[index] =
@@ -144,17 +149,10 @@ int STDCALL SolveBoardPBN(
   int thrId)
 {
   deal dl;
-  if (ConvertFromPBN(dlpbn.remainCards, dl.remainCards) != RETURN_NO_FAULT)
+  if (ConvertDealsFromPBN(&dlpbn, 1, &dl, false, nullptr) !=
+      RETURN_NO_FAULT)
     return RETURN_PBN_FAULT;
 
-  for (int k = 0; k <= 2; k++)
-  {
-    dl.currentTrickRank[k] = dlpbn.currentTrickRank[k];
-    dl.currentTrickSuit[k] = dlpbn.currentTrickSuit[k];
-  }
-  dl.first = dlpbn.first;
-  dl.trump = dlpbn.trump;
-
   int res = SolveBoard(dl, target, solutions, mode, futp, thrId);
   return res;
 }
@@ -174,20 +172,12 @@ int STDCALL SolveAllBoards(
     bo.mode[k] = bop->mode[k];
     bo.solutions[k] = bop->solutions[k];
     bo.target[k] = bop->target[k];
-    bo.deals[k].first = bop->deals[k].first;
-    bo.deals[k].trump = bop->deals[k].trump;
-
-    for (int i = 0; i <= 2; i++)
-    {
-      bo.deals[k].currentTrickSuit[i] = bop->deals[k].currentTrickSuit[i];
-      bo.deals[k].currentTrickRank[i] = bop->deals[k].currentTrickRank[i];
-    }
-
-    if (ConvertFromPBN(bop->deals[k].remainCards, bo.deals[k].remainCards) 
-        != 1)
-      return RETURN_PBN_FAULT;
   }
 
+  if (ConvertDealsFromPBN(bop->deals, bop->noOfBoards, bo.deals, false,
+      nullptr) != RETURN_NO_FAULT)
+    return RETURN_PBN_FAULT;
+
   int res = SolveAllBoardsN(bo, * solvedp);
   return res;
 }
@@ -201,6 +191,57 @@ int STDCALL SolveAllBoardsBin(
 }
 
 
+int STDCALL ReadDealFile(
+  int first,
+  int number,
+  boards * bop,
+  int * dealerp,
+  int * vulnerablep)
+{
+  if (number > MAXNOOFBOARDS)
+    return RETURN_TOO_MANY_BOARDS;
+
+  if (first < 0 || number < 0 ||
+      static_cast<unsigned long long>(first) +
+        static_cast<unsigned long long>(number) > dealFile.Number())
+    return RETURN_DEAL_FILE;
+
+  dealFileInfoType info[MAXNOOFBOARDS];
+  if (! dealFile.Read(static_cast<unsigned long long>(first), number,
+      bop->deals, info))
+    return RETURN_DEAL_FILE;
+
+  bop->noOfBoards = number;
+  for (int k = 0; k < number; k++)
+  {
+    bop->target[k] = info[k].target;
+    bop->solutions[k] = info[k].solutions;
+    bop->mode[k] = info[k].mode;
+
+    if (dealerp)
+      dealerp[k] = info[k].dealer;
+    if (vulnerablep)
+      vulnerablep[k] = info[k].vulnerable;
+  }
+
+  return RETURN_NO_FAULT;
+}
+
+
+int STDCALL SolveDealFile(
+  int first,
+  int number,
+  solvedBoards * solvedp)
+{
+  boards bo;
+  const int res = ReadDealFile(first, number, &bo, nullptr, nullptr);
+  if (res != RETURN_NO_FAULT)
+    return res;
+
+  return SolveAllBoardsN(bo, * solvedp);
+}
+
+
 int STDCALL SolveAllChunksPBN(
   boardsPBN * bop, 
   solvedBoards * solvedp, 
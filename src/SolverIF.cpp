@@ -47,19 +47,55 @@ void LastTrickWinner(
   int& leadSuit,
   int& leadSideWins);
 
-bool (* AB_ptr_list[DDS_HANDS])(
+typedef bool (* ABsearchPtr)(
   pos * posPoint,
   const int target,
   const int depth,
-  ThreadData * thrp)
-  = { ABsearch, ABsearch1, ABsearch2, ABsearch3 };
+  ThreadData * thrp);
 
-bool (* AB_ptr_trace_list[DDS_HANDS])(
-  pos * posPoint,
+// The search instantiations per strain policy, indexed by
+// STRAIN_NO(trump) and then by handRelFirst.
+#define STRAIN_NO(trump) ((trump) == DDS_NOTRUMP ? 0 : 1)
+
+// Consecutive root steps in one direction before SearchRoot
+// switches from stepping to bisection.
+#define ROOT_BISECT_RUN 3
+
+ABsearchPtr AB_ptr_list[2][DDS_HANDS] =
+{
+  { ABsearch<StrainNT>, ABsearch1<StrainNT>,
+    ABsearch2<StrainNT>, ABsearch3<StrainNT> },
+  { ABsearch<StrainSuit>, ABsearch1<StrainSuit>,
+    ABsearch2<StrainSuit>, ABsearch3<StrainSuit> }
+};
+
+ABsearchPtr AB_ptr_trace_list[2][DDS_HANDS] =
+{
+  { ABsearch0<StrainNT>, ABsearch1<StrainNT>,
+    ABsearch2<StrainNT>, ABsearch3<StrainNT> },
+  { ABsearch0<StrainSuit>, ABsearch1<StrainSuit>,
+    ABsearch2<StrainSuit>, ABsearch3<StrainSuit> }
+};
+
+int RootGuess(
+  ThreadData const * thrp,
+  const int first,
+  const int tricks);
+
+void SolveOtherCards(
+  ThreadData * thrp,
+  ABsearchPtr ABsearchFnc,
   const int target,
-  const int depth,
-  ThreadData * thrp)
-  = { ABsearch0, ABsearch1, ABsearch2, ABsearch3 };
+  const int noMoves,
+  futureTricks * futp);
+
+int SearchRoot(
+  ThreadData * thrp,
+  ABsearchPtr ABsearchFnc,
+  const int guessArg,
+  const int lowerArg,
+  const int upperArg,
+  moveType& bestMove);
 
 void (* Make_ptr_list[3])(
   pos * posPoint,
@@ -100,6 +136,10 @@ int SolveBoardInternal(
   if (ret != RETURN_NO_FAULT)
     return ret;
 
+  // Whatever we solve now, a game session on the thread has to
+  // set up its position again.
+  thrp->sessionSynced = false;
+
   // ----------------------------------------------------------
   // Count and classify deal.
   // ----------------------------------------------------------
@@ -110,7 +150,7 @@ int SolveBoardInternal(
   unsigned aggDeal = 0;
   bool similarDeal;
   int cardCount = 0;
-  int ind, forb, noMoves;
+  int noMoves;
 
   for (int h = 0; h < DDS_HANDS; h++)
   {
@@ -142,6 +182,13 @@ int SolveBoardInternal(
   else
     similarDeal = false;
 
+  if (newDeal && ! similarDeal)
+  {
+    for (int st = 0; st < DDS_STRAINS; st++)
+      for (int h = 0; h < DDS_HANDS; h++)
+        thrp->rootScore[st][h] = -1;
+  }
+
   if (dl.trump != thrp->trump)
     newTrump = true;
 
@@ -151,6 +198,10 @@ int SolveBoardInternal(
 
   thrp->trump = dl.trump;
 
+  // From here on the search only runs the instantiation for the
+  // strain, so it does not need to test for a trump suit itself.
+  ABsearchPtr const * ABsearchList = AB_ptr_list[STRAIN_NO(dl.trump)];
+
   thrp->iniDepth = cardCount - 4;
   int iniDepth = thrp->iniDepth;
   int trick = (iniDepth + 3) >> 2;
@@ -338,40 +389,21 @@ int SolveBoardInternal(
 
   if (solutions == 3)
   {
-    // 7 for hand 0 and 2, 6 for hand 1 and 3
-    int guess = 7 - (handToPlay & 0x1);
+    int guess = (handRelFirst == 0 ?
+      RootGuess(thrp, dl.first, cardCount >> 2) :
+      7 - (handToPlay & 0x1));
     int upperbound = 13;
     int lowerbound = 0;
     futp->cards = noMoves;
 
     for (int mno = 0; mno < noMoves; mno++)
     {
-      do
-      {
-        ResetBestMoves(thrp);
-
-        TIMER_START(TIMER_NO_AB, iniDepth);
-        thrp->val = (* AB_ptr_list[handRelFirst])(
-                      &thrp->lookAheadPos,
-                      guess,
-                      iniDepth,
-                      thrp);
-        TIMER_END(TIMER_NO_AB, iniDepth);
-
-#ifdef DDS_TOP_LEVEL
-        DumpTopLevel(thrp->fileTopLevel.GetStream(), 
-          * thrp, guess, lowerbound, upperbound, 1);
-#endif
+      // Later cards cannot score more than the ones before them.
+      lowerbound = SearchRoot(thrp, ABsearchList[handRelFirst],
+        guess, 0, upperbound, mv);
 
-        if (thrp->val)
-        {
-          mv = thrp->bestMove[iniDepth];
-          lowerbound = guess++;
-        }
-        else
-          upperbound = --guess;
-      }
-      while (lowerbound < upperbound);
+      if (mno == 0 && handRelFirst == 0)
+        thrp->rootScore[dl.trump][dl.first] = lowerbound;
 
       if (lowerbound)
       {
@@ -386,7 +418,7 @@ int SolveBoardInternal(
         thrp->forbiddenMoves[mno + 1].rank = mv.rank;
 
         guess = lowerbound;
-        lowerbound = 0;
+        upperbound = lowerbound;
       }
       else
       {
@@ -439,36 +471,14 @@ int SolveBoardInternal(
 
   else if (target == -1)
   {
-    // 7 for hand 0 and 2, 6 for hand 1 and 3
-    int guess = 7 - (handToPlay & 0x1);
-    int upperbound = 13;
-    int lowerbound = 0;
-    do
-    {
-      ResetBestMoves(thrp);
+    int guess = (handRelFirst == 0 ?
+      RootGuess(thrp, dl.first, cardCount >> 2) :
+      7 - (handToPlay & 0x1));
+    int lowerbound = SearchRoot(thrp, ABsearchList[handRelFirst],
+      guess, 0, 13, mv);
 
-      TIMER_START(TIMER_NO_AB, iniDepth);
-      thrp->val = (* AB_ptr_list[handRelFirst])(&thrp->lookAheadPos,
-                  guess,
-                  iniDepth,
-                  thrp);
-      TIMER_END(TIMER_NO_AB, iniDepth);
-
-#ifdef DDS_TOP_LEVEL
-      DumpTopLevel(thrp->fileTopLevel.GetStream(),
-        * thrp, guess, lowerbound, upperbound, 1);
-#endif
-
-      if (thrp->val)
-      {
-        mv = thrp->bestMove[iniDepth];
-        lowerbound = guess++;
-      }
-      else
-        upperbound = --guess;
-
-    }
-    while (lowerbound < upperbound);
+    if (handRelFirst == 0)
+      thrp->rootScore[dl.trump][dl.first] = lowerbound;
 
     thrp->bestMove[iniDepth] = mv;
     if (lowerbound == 0)
@@ -514,7 +524,7 @@ int SolveBoardInternal(
   else
   {
     TIMER_START(TIMER_NO_AB, iniDepth);
-    thrp->val = (* AB_ptr_list[handRelFirst])(
+    thrp->val = (* ABsearchList[handRelFirst])(
                   &thrp->lookAheadPos,
                   target,
                   iniDepth,
@@ -555,53 +565,8 @@ int SolveBoardInternal(
   // This applies both to target == -1 and target >= 1.
   // ----------------------------------------------------------
 
-  forb = 1;
-  ind = 1;
-
-  while (ind < noMoves)
-  {
-    // Moves up to and including bestMove are now forbidden.
-
-    thrp->moves.Rewind(trick, handRelFirst);
-    int num = thrp->moves.GetLength(trick, handRelFirst);
-
-    for (int k = 0; k < num; k++)
-    {
-      moveType const * mp = 
-        thrp->moves.MakeNextSimple(trick, handRelFirst);
-      thrp->forbiddenMoves[forb] = * mp;
-      forb++;
-
-      if ((thrp->bestMove[iniDepth].suit == mp->suit) &&
-          (thrp->bestMove[iniDepth].rank == mp->rank))
-        break;
-    }
-
-    ResetBestMoves(thrp);
-
-    TIMER_START(TIMER_NO_AB, iniDepth);
-    thrp->val = (* AB_ptr_list[handRelFirst])(
-                  &thrp->lookAheadPos,
-                  futp->score[0],
-                  iniDepth,
-                  thrp);
-    TIMER_END(TIMER_NO_AB, iniDepth);
-
-#ifdef DDS_TOP_LEVEL
-    DumpTopLevel(thrp->fileTopLevel.GetStream(),
-      * thrp, target, -1, -1, 2);
-#endif
-
-    if (! thrp->val)
-      break;
-
-    futp->cards = ind + 1;
-    futp->suit[ind] = thrp->bestMove[iniDepth].suit;
-    futp->rank[ind] = thrp->bestMove[iniDepth].rank;
-    futp->equals[ind] = thrp->bestMove[iniDepth].sequence << 2;
-    futp->score[ind] = futp->score[0];
-    ind++;
-  }
+  SolveOtherCards(thrp, ABsearchList[handRelFirst], target, noMoves,
+    futp);
 
 
 SOLVER_STATS:
@@ -697,33 +662,11 @@ int SolveSameBoard(
 
   thrp->moves.Reinit(trick, dl.first);
 
-  int guess = hint;
-  int lowerbound = 0;
-  int upperbound = 13;
+  moveType mv;
+  int lowerbound = SearchRoot(thrp, AB_ptr_list[STRAIN_NO(thrp->trump)][0],
+    hint, 0, 13, mv);
 
-  do
-  {
-    ResetBestMoves(thrp);
-
-    TIMER_START(TIMER_NO_AB, iniDepth);
-    thrp->val = ABsearch(
-                  &thrp->lookAheadPos,
-                  guess,
-                  iniDepth,
-                  thrp);
-    TIMER_END(TIMER_NO_AB, iniDepth);
-
-#ifdef DDS_TOP_LEVEL
-    DumpTopLevel(thrp->fileTopLevel.GetStream(),
-      * thrp, guess, lowerbound, upperbound, 1);
-#endif
-
-    if (thrp->val)
-      lowerbound = guess++;
-    else
-      upperbound = --guess;
-  }
-  while (lowerbound < upperbound);
+  thrp->rootScore[thrp->trump][dl.first] = lowerbound;
 
   futp->cards = 1;
   futp->score[0] = lowerbound;
@@ -768,6 +711,44 @@ int SolveSameBoard(
 }
 
 
+void PlayLaterCard(
+  ThreadData * thrp,
+  moveType const * move)
+{
+  // Plays a card in the position that the PlayAnalyser keeps in
+  // the thread, without solving the new position. The next
+  // SolveBoard() must then set up the deal again.
+
+  thrp->analysisFlag = true;
+
+  int iniDepth = --thrp->iniDepth;
+  int trick = (iniDepth + 3) >> 2;
+  int handRelFirst = (48 - iniDepth) % 4;
+
+  if (handRelFirst == 0)
+  {
+    thrp->moves.MakeSpecific(* move, trick + 1, 3);
+    unsigned short int ourWinRanks[DDS_SUITS]; // Unused here
+    Make3(&thrp->lookAheadPos, ourWinRanks, iniDepth + 1, move, thrp);
+  }
+  else if (handRelFirst == 1)
+  {
+    thrp->moves.MakeSpecific(* move, trick, 0);
+    Make0(&thrp->lookAheadPos, iniDepth + 1, move);
+  }
+  else if (handRelFirst == 2)
+  {
+    thrp->moves.MakeSpecific(* move, trick, 1);
+    Make1(&thrp->lookAheadPos, iniDepth + 1, move);
+  }
+  else
+  {
+    thrp->moves.MakeSpecific(* move, trick, 2);
+    Make2(&thrp->lookAheadPos, iniDepth + 1, move);
+  }
+}
+
+
 int AnalyseLaterBoard(
   ThreadData * thrp,
   const int leadHand,
@@ -781,14 +762,16 @@ int AnalyseLaterBoard(
   // makes heavy reuse of parameters that are already stored in
   // various places. It corresponds to:
   // target == -1, solutions == 1, mode == 2.
-  // The function only needs to return fut.score[0].
+  // The function only needs to return fut.score[0]. If the search
+  // proves a card to be optimal on the way, it is returned as well
+  // (fut.cards == 1), otherwise fut.cards is 0.
 
-  int iniDepth = --thrp->iniDepth;
+  PlayLaterCard(thrp, move);
+
+  int iniDepth = thrp->iniDepth;
   int cardCount = iniDepth + 4;
-  int trick = (iniDepth + 3) >> 2;
   int handRelFirst = (48 - iniDepth) % 4;
   thrp->trickNodes = 0;
-  thrp->analysisFlag = true;
   int handToPlay = handId(leadHand, handRelFirst);
 
   if (handToPlay == 0 || handToPlay == 2)
@@ -806,34 +789,15 @@ int AnalyseLaterBoard(
     thrp->nodeTypeStore[3] = MAXNODE;
   }
 
-  if (handRelFirst == 0)
-  {
-    thrp->moves.MakeSpecific(* move, trick + 1, 3);
-    unsigned short int ourWinRanks[DDS_SUITS]; // Unused here
-    Make3(&thrp->lookAheadPos, ourWinRanks, iniDepth + 1, move, thrp);
-  }
-  else if (handRelFirst == 1)
-  {
-    thrp->moves.MakeSpecific(* move, trick, 0);
-    Make0(&thrp->lookAheadPos, iniDepth + 1, move);
-  }
-  else if (handRelFirst == 2)
-  {
-    thrp->moves.MakeSpecific(* move, trick, 1);
-    Make1(&thrp->lookAheadPos, iniDepth + 1, move);
-  }
-  else
-  {
-    thrp->moves.MakeSpecific(* move, trick, 2);
-    Make2(&thrp->lookAheadPos, iniDepth + 1, move);
-  }
-
   if (cardCount <= 4)
   {
     // Last trick.
-    evalType eval = Evaluate(&thrp->lookAheadPos, thrp->trump, thrp);
+    evalType eval = (thrp->trump == DDS_NOTRUMP ?
+      Evaluate<StrainNT>(&thrp->lookAheadPos, thrp->trump, thrp) :
+      Evaluate<StrainSuit>(&thrp->lookAheadPos, thrp->trump, thrp));
     futp->score[0] = eval.tricks;
     futp->nodes = 0;
+    futp->cards = 0;
 
     return RETURN_NO_FAULT;
   }
@@ -847,10 +811,13 @@ int AnalyseLaterBoard(
   thrp->nodes = 0;
 #endif
 
-  int guess = hint,
-      lowerbound,
+  int lowerbound,
       upperbound;
 
+  ABsearchPtr const * ABsearchList =
+    AB_ptr_trace_list[STRAIN_NO(thrp->trump)];
+
+  // The hint is a bound that we don't need to search again.
   if (hintDir == 0)
   {
     lowerbound = hint;
@@ -862,34 +829,19 @@ int AnalyseLaterBoard(
     upperbound = hint;
   }
 
-  do
-  {
-    ResetBestMoves(thrp);
-
-    TIMER_START(TIMER_NO_AB, iniDepth);
-    thrp->val = (* AB_ptr_trace_list[handRelFirst])(
-                  &thrp->lookAheadPos,
-                  guess,
-                  iniDepth,
-                  thrp);
-    TIMER_END(TIMER_NO_AB, iniDepth);
-
-#ifdef DDS_TOP_LEVEL
-    DumpTopLevel(thrp->fileTopLevel.GetStream(),
-      * thrp, guess, lowerbound, upperbound, 1);
-#endif
-
-    if (thrp->val)
-      lowerbound = guess++;
-    else
-      upperbound = --guess;
-
-  }
-  while (lowerbound < upperbound);
-
-  futp->score[0] = lowerbound;
+  // mv is only set by a search that reaches its target. The last
+  // such search is at the final score, so mv is then optimal.
+  moveType mv;
+  mv.rank = 0;
+  futp->score[0] = SearchRoot(thrp, ABsearchList[handRelFirst],
+    hint, lowerbound, upperbound, mv);
   futp->nodes = thrp->trickNodes;
 
+  futp->cards = (mv.rank == 0 ? 0 : 1);
+  futp->suit[0] = mv.suit;
+  futp->rank[0] = mv.rank;
+  futp->equals[0] = mv.sequence << 2;
+
   thrp->memUsed = thrp->transTable->MemoryInUse() +
                   ThreadMemoryUsed();
 
@@ -928,6 +880,207 @@ int AnalyseLaterBoard(
 }
 
 
+int SolveLaterBoard(
+  ThreadData * thrp,
+  const int leadHand,
+  moveType const * move,
+  const int guess,
+  const int solutions,
+  futureTricks * futp)
+{
+  // Specialized function for game sessions. Like AnalyseLaterBoard,
+  // but there are no known bounds, and the optimal cards are
+  // returned as well. It corresponds to:
+  // target == -1, solutions == 1 or 2, mode == 2.
+  // There must be more than one trick left after the card.
+
+  PlayLaterCard(thrp, move);
+
+  int iniDepth = thrp->iniDepth;
+  int trick = (iniDepth + 3) >> 2;
+  int handRelFirst = (48 - iniDepth) % 4;
+  thrp->trickNodes = 0;
+  int handToPlay = handId(leadHand, handRelFirst);
+
+  if (handToPlay == 0 || handToPlay == 2)
+  {
+    thrp->nodeTypeStore[0] = MAXNODE;
+    thrp->nodeTypeStore[1] = MINNODE;
+    thrp->nodeTypeStore[2] = MAXNODE;
+    thrp->nodeTypeStore[3] = MINNODE;
+  }
+  else
+  {
+    thrp->nodeTypeStore[0] = MINNODE;
+    thrp->nodeTypeStore[1] = MAXNODE;
+    thrp->nodeTypeStore[2] = MINNODE;
+    thrp->nodeTypeStore[3] = MAXNODE;
+  }
+
+#ifdef DDS_AB_STATS
+  thrp->ABStats.Reset();
+  thrp->ABStats.ResetCum();
+#endif
+
+#ifdef DDS_TOP_LEVEL
+  thrp->nodes = 0;
+#endif
+
+  // Not the trace versions, as these may answer from the TT or
+  // from quick tricks at the root without finding a card.
+  ABsearchPtr const * ABsearchList =
+    AB_ptr_list[STRAIN_NO(thrp->trump)];
+
+  moveType mv;
+  mv.rank = 0;
+  int score = SearchRoot(thrp, ABsearchList[handRelFirst],
+    guess, 0, 13, mv);
+
+  if (handRelFirst == 0)
+    thrp->rootScore[thrp->trump][leadHand] = score;
+
+  futp->nodes = thrp->trickNodes;
+  futp->cards = 1;
+  futp->score[0] = score;
+  futp->suit[0] = mv.suit;
+  futp->rank[0] = mv.rank;
+  futp->equals[0] = mv.sequence << 2;
+
+  if (score == 0)
+  {
+    // No search reached its target, and all cards are equally bad.
+    // Take the first one or all of them, as SolveBoard() does.
+    if (handRelFirst == 0)
+      thrp->moves.MoveGen0(
+        trick,
+        thrp->lookAheadPos,
+        thrp->bestMove[iniDepth],
+        thrp->bestMoveTT[iniDepth],
+        thrp->rel);
+    else
+      thrp->moves.MoveGen123(
+        trick,
+        handRelFirst,
+        thrp->lookAheadPos);
+
+    const int noMoves = thrp->moves.GetLength(trick, handRelFirst);
+    futp->cards = (solutions == 1 ? 1 : noMoves);
+
+    for (int i = 0; i < futp->cards; i++)
+    {
+      moveType const * mp =
+        thrp->moves.MakeNextSimple(trick, handRelFirst);
+
+      futp->score[i] = 0;
+      futp->suit[i] = mp->suit;
+      futp->rank[i] = mp->rank;
+      futp->equals[i] = mp->sequence << 2;
+    }
+  }
+  else if (solutions == 2)
+  {
+    // The last search of SearchRoot may have failed one trick
+    // higher. One that just reaches the score leaves the root moves
+    // in the order it tried them, which SolveOtherCards needs.
+    thrp->val = (* ABsearchList[handRelFirst])(
+                  &thrp->lookAheadPos,
+                  score,
+                  iniDepth,
+                  thrp);
+
+    futp->suit[0] = thrp->bestMove[iniDepth].suit;
+    futp->rank[0] = thrp->bestMove[iniDepth].rank;
+    futp->equals[0] = thrp->bestMove[iniDepth].sequence << 2;
+
+    SolveOtherCards(thrp, ABsearchList[handRelFirst], -1,
+      thrp->moves.GetLength(trick, handRelFirst), futp);
+
+    for (int k = 0; k <= 13; k++)
+    {
+      thrp->forbiddenMoves[k].rank = 0;
+      thrp->forbiddenMoves[k].suit = 0;
+    }
+    futp->nodes = thrp->trickNodes;
+  }
+
+  thrp->memUsed = thrp->transTable->MemoryInUse() +
+                  ThreadMemoryUsed();
+
+#ifdef DDS_TIMING
+  thrp->timerList.PrintStats(thrp->fileTimerList.GetStream());
+#endif
+
+  return RETURN_NO_FAULT;
+}
+
+
+void SolveOtherCards(
+  ThreadData * thrp,
+  ABsearchPtr ABsearchFnc,
+  const int target,
+  const int noMoves,
+  futureTricks * futp)
+{
+  // The first card is in futp with a score > 0. Finds the other
+  // cards with that score, each time forbidding the cards up to
+  // and including the last one found.
+
+  const int iniDepth = thrp->iniDepth;
+  const int trick = (iniDepth + 3) >> 2;
+  const int handRelFirst = (48 - iniDepth) % 4;
+
+  int forb = 1;
+  int ind = 1;
+
+  while (ind < noMoves)
+  {
+    // Moves up to and including bestMove are now forbidden.
+
+    thrp->moves.Rewind(trick, handRelFirst);
+    int num = thrp->moves.GetLength(trick, handRelFirst);
+
+    for (int k = 0; k < num; k++)
+    {
+      moveType const * mp = 
+        thrp->moves.MakeNextSimple(trick, handRelFirst);
+      thrp->forbiddenMoves[forb] = * mp;
+      forb++;
+
+      if ((thrp->bestMove[iniDepth].suit == mp->suit) &&
+          (thrp->bestMove[iniDepth].rank == mp->rank))
+        break;
+    }
+
+    ResetBestMoves(thrp);
+
+    TIMER_START(TIMER_NO_AB, iniDepth);
+    thrp->val = (* ABsearchFnc)(
+                  &thrp->lookAheadPos,
+                  futp->score[0],
+                  iniDepth,
+                  thrp);
+    TIMER_END(TIMER_NO_AB, iniDepth);
+
+#ifdef DDS_TOP_LEVEL
+    DumpTopLevel(thrp->fileTopLevel.GetStream(),
+      * thrp, target, -1, -1, 2);
+#else
+    UNUSED(target);
+#endif
+
+    if (! thrp->val)
+      break;
+
+    futp->cards = ind + 1;
+    futp->suit[ind] = thrp->bestMove[iniDepth].suit;
+    futp->rank[ind] = thrp->bestMove[iniDepth].rank;
+    futp->equals[ind] = thrp->bestMove[iniDepth].sequence << 2;
+    futp->score[ind] = futp->score[0];
+    ind++;
+  }
+}
+
+
 int BoardRangeChecks(
   const deal& dl,
   const int target,
@@ -1197,3 +1350,103 @@ void LastTrickWinner(
     partner[handToPlay] == maxHand) ? 1 : 0);
 }
 
+
+int RootGuess(
+  ThreadData const * thrp,
+  const int first,
+  const int tricks)
+{
+  // A result for the same deal makes a better guess than a fixed
+  // one. The partner's lead gives about the same number of tricks
+  // for the leading side, and an opponent's lead the complement.
+  // Failing that, another strain with the same leader will do.
+  int const * scores = thrp->rootScore[thrp->trump];
+
+  if (scores[first] >= 0)
+    return scores[first];
+  else if (scores[partner[first]] >= 0)
+    return scores[partner[first]];
+  else if (scores[lho[first]] >= 0)
+    return tricks - scores[lho[first]];
+  else if (scores[rho[first]] >= 0)
+    return tricks - scores[rho[first]];
+
+  for (int s = 0; s < DDS_STRAINS; s++)
+  {
+    if (thrp->rootScore[s][first] >= 0)
+      return thrp->rootScore[s][first];
+  }
+
+  // 7 for hand 0 and 2, 6 for hand 1 and 3
+  return 7 - (first & 0x1);
+}
+
+
+int SearchRoot(
+  ThreadData * thrp,
+  ABsearchPtr ABsearchFnc,
+  const int guessArg,
+  const int lowerArg,
+  const int upperArg,
+  moveType& bestMove)
+{
+  // Finds the score between lowerArg, which is known to be reached,
+  // and upperArg with null-window searches from the root. We step
+  // one trick at a time from the guess as in MTD(f), which is the
+  // cheapest way when the guess is close. When ROOT_BISECT_RUN steps
+  // in a row go the same way, the guess was poor, and we bisect the
+  // rest of the interval.
+
+  const int iniDepth = thrp->iniDepth;
+  int lowerbound = lowerArg;
+  int upperbound = upperArg;
+  int guess = guessArg;
+  int lastVal = -1;
+  int run = 0;
+  bool bisect = false;
+
+  while (lowerbound < upperbound)
+  {
+    if (guess <= lowerbound)
+      guess = lowerbound + 1;
+    else if (guess > upperbound)
+      guess = upperbound;
+
+    ResetBestMoves(thrp);
+    thrp->searchStats.rootSearches++;
+
+    TIMER_START(TIMER_NO_AB, iniDepth);
+    thrp->val = (* ABsearchFnc)(
+                  &thrp->lookAheadPos,
+                  guess,
+                  iniDepth,
+                  thrp);
+    TIMER_END(TIMER_NO_AB, iniDepth);
+
+#ifdef DDS_TOP_LEVEL
+    DumpTopLevel(thrp->fileTopLevel.GetStream(),
+      * thrp, guess, lowerbound, upperbound, 1);
+#endif
+
+    const int val = (thrp->val ? 1 : 0);
+    if (val)
+    {
+      bestMove = thrp->bestMove[iniDepth];
+      lowerbound = guess;
+    }
+    else
+      upperbound = guess - 1;
+
+    run = (val == lastVal ? run + 1 : 1);
+    if (run >= ROOT_BISECT_RUN)
+      bisect = true;
+    lastVal = val;
+
+    if (bisect)
+      guess = (lowerbound + upperbound + 1) >> 1;
+    else
+      guess += (val ? 1 : -1);
+  }
+
+  return lowerbound;
+}
@@ -28,6 +28,10 @@ int SolveSameBoard(
   futureTricks * futp,
   const int hint);
 
+void PlayLaterCard(
+  ThreadData * thrp,
+  moveType const * move);
+
 int AnalyseLaterBoard(
   ThreadData * thrp,
   const int leadHand,
@@ -36,4 +40,12 @@ int AnalyseLaterBoard(
   const int hintDir,
   futureTricks * futp);
 
+int SolveLaterBoard(
+  ThreadData * thrp,
+  const int leadHand,
+  moveType const * move,
+  const int guess,
+  const int solutions,
+  futureTricks * futp);
+
 #endif
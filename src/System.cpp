@@ -8,7 +8,9 @@
 */
 
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <future>
 #include <iostream>
 #include <iomanip>
@@ -208,6 +210,34 @@ int System::RunThreads(paramType &param, RunMode runCat, const boards& bop)
   return RunThreadsSTLAsync(param, runCat, scheduler);
 }
 
+void System::RunThreadsRange(
+  const int number,
+  const int chunkSize,
+  const function<void(const int, const int)>& fn)
+{
+  // The threads take the next chunk until there are none left. The
+  // calling thread works as well, so a single chunk stays in it.
+  std::atomic<int> next(0);
+  auto worker = [&]()
+  {
+    int first;
+    while ((first = next.fetch_add(chunkSize)) < number)
+      fn(first, min(first + chunkSize, number));
+  };
+
+  const int numChunks = (number + chunkSize - 1) / chunkSize;
+  const unsigned nu = static_cast<unsigned>(min(numThreads, numChunks));
+
+  std::vector<std::future<void>> futures;
+  for (unsigned k = 1; k < nu; k++)
+    futures.push_back(std::async(std::launch::async, worker));
+
+  worker();
+
+  for (auto& f: futures)
+    f.wait();
+}
+
 
 //////////////////////////////////////////////////////////////////////
 //                     Self-identification                          //
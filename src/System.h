@@ -17,6 +17,7 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <functional>
 
 #include "dds.h"
 
@@ -35,6 +36,11 @@ typedef void (*fduplType)(
 typedef void (*fsingleType)(paramType &param, const int thid, const int bno);
 typedef void (*fcopyType)(paramType &param, const vector<int>& crossrefs);
 
+// Items per call of fn in RunThreadsRange for the batch conversions
+// and par functions. An item takes about a microsecond there, so
+// smaller batches stay in the calling thread.
+#define DDS_RANGE_CHUNK_SIZE 4096
+
 
 class System
 {
@@ -110,6 +116,16 @@ class System
         const boards& bop,
         const playTracesBin& pl);
 
+    // For work without thread data: calls fn(first, last) on ranges
+    // of at most chunkSize of the number items, on up to all threads.
+    // Like RunThreads it uses std::async, which is the only threading
+    // model left. It does not occupy threads of the ThreadMgr, as fn
+    // needs no thread data, so it can run next to a solve.
+    void RunThreadsRange(
+      const int number,
+      const int chunkSize,
+      const function<void(const int, const int)>& fn);
+
     string str(DDSInfo * info) const;
 };
 
@@ -36,6 +36,15 @@ enum TTresetReason
   TT_RESET_SIZE = 6
 };
 
+struct TTstatsType
+{
+  long long lookups;
+  long long hits;
+  long long stores;
+  long long reclaims;
+  long long resets[TT_RESET_SIZE];
+};
+
 struct nodeCardsType // 8 bytes
 {
   char ubound; // For N-S
@@ -47,9 +56,27 @@ struct nodeCardsType // 8 bytes
 
 class TransTable
 {
+  protected:
+    // Always-on counters, cheap enough to keep in release builds.
+    TTstatsType stats;
+
   public:
+    TransTable() { TransTable::ResetStats(); };
+
     virtual ~TransTable() {};
 
+    const TTstatsType& GetStats() const { return stats; };
+
+    void ResetStats()
+    {
+      stats.lookups = 0;
+      stats.hits = 0;
+      stats.stores = 0;
+      stats.reclaims = 0;
+      for (int r = 0; r < TT_RESET_SIZE; r++)
+        stats.resets[r] = 0;
+    };
+
     virtual void Init(const int handLookup[][15]) = 0;
 
     virtual void SetMemoryDefault(const int megabytes) = 0;
@@ -80,6 +107,14 @@ class TransTable
       const nodeCardsType& first,
       const bool flag) = 0;
 
+    // A hint that Lookup will soon be called for this position.
+    // Only needs to work out where the entry lives, not find it.
+    virtual void Prefetch(
+      const int /*trick*/,
+      const int /*hand*/,
+      const unsigned short[] /*aggrTarget[]*/,
+      const int[] /*handDist[]*/) {};
+
     virtual void PrintSuits(
       ofstream& /*fout*/,
       const int /*trick*/,
@@ -76,6 +76,15 @@
    It's not really AKQJ, but the four highest cards still in
    play in that suit. So missing cards are always at the end
    of the list.
+
+   A stored entry only keeps the first three of these sets
+   (twelve cards per suit). The masks are not stored at all, as
+   they only depend on how many cards of each suit are relevant,
+   and this is already encoded in maskIndex (one nibble per suit,
+   15 minus the number of cards). topMaskHigh and topMaskLow turn
+   the two bytes of maskIndex back into the masks. The 13th card
+   of a suit never has to be checked: If all the other cards in
+   the suit match, the suit lengths already say who holds it.
 */
 
 
@@ -86,6 +95,16 @@
 #include "TransTableL.h"
 #include "debug.h"
 
+#if defined(__GNUC__) || defined(__clang__)
+  #define TT_PREFETCH(p) __builtin_prefetch(p)
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  #include <xmmintrin.h>
+  #define TT_PREFETCH(p) \
+    _mm_prefetch(reinterpret_cast<char const *>(p), _MM_HINT_T0)
+#else
+  #define TT_PREFETCH(p) UNUSED(p)
+#endif
+
 
 extern unsigned char cardRank[16];
 extern char relRank[8192][15];
@@ -93,6 +112,8 @@ extern char relRank[8192][15];
 static bool _constantsSet = false;
 static int TTlowestRank[8192];
 static unsigned maskBytes[8192][DDS_SUITS][TT_BYTES];
+static unsigned topMaskHigh[256][TT_BYTES-1];
+static unsigned topMaskLow[256][TT_BYTES-1];
 
 static vector<string> players =
 {
@@ -114,17 +135,14 @@ TransTableL::TransTableL()
   pagesCurrent = 0;
 
   memState = FROM_POOL;
-  harvestTrick = FIRST_HARVEST_TRICK;
-  harvestHand = 0;
-
-  harvested.nextBlockNo = 0;
-
-  timestamp = 0;
+  clockTrick = 0;
+  clockHand = 0;
+  clockHash = 0;
+  clockSlot = 0;
 
   pageStats.numResets = 0;
   pageStats.numCallocs = 0;
   pageStats.numFrees = 0;
-  pageStats.numHarvests = 0;
   pageStats.lastCurrent = 0;
 
   TTInUse = 0;
@@ -177,6 +195,22 @@ void TransTableL::SetConstants()
 
     TTlowestRank[ind] = TTlowestRank[ind ^ topBitRank] - 1;
   }
+
+  // Each byte of maskIndex holds the lowest ranks of two suits.
+  // A rank below 2 never occurs, and its mask stays empty.
+  for (unsigned b = 0; b < 256; b++)
+  {
+    const unsigned lowA = b >> 4;
+    const unsigned lowB = b & 0xf;
+    const unsigned indA = (lowA < 2 ? 0 : (1u << (15 - lowA)) - 1);
+    const unsigned indB = (lowB < 2 ? 0 : (1u << (15 - lowB)) - 1);
+
+    for (unsigned k = 0; k < TT_BYTES-1; k++)
+    {
+      topMaskHigh[b][k] = maskBytes[indA][0][k] | maskBytes[indB][1][k];
+      topMaskLow[b][k] = maskBytes[indA][2][k] | maskBytes[indB][3][k];
+    }
+  }
 }
 
 
@@ -327,10 +361,10 @@ void TransTableL::ReleaseTT()
 
 void TransTableL::ResetMemory(const TTresetReason reason)
 {
-  UNUSED(reason);
   if (poolp == nullptr)
     return;
 
+  stats.resets[reason]++;
   pageStats.numResets++;
   pageStats.numCallocs += pagesCurrent - pageStats.lastCurrent;
   pageStats.lastCurrent = pagesCurrent;
@@ -357,9 +391,11 @@ void TransTableL::ResetMemory(const TTresetReason reason)
 
   TransTableL::InitTT();
 
-  timestamp = 0;
-
   memState = FROM_POOL;
+  clockTrick = 0;
+  clockHand = 0;
+  clockHash = 0;
+  clockSlot = 0;
 
   return;
 }
@@ -388,7 +424,6 @@ void TransTableL::ReturnAllMemory()
   pageStats.numResets = 0;
   pageStats.numCallocs = 0;
   pageStats.numFrees = 0;
-  pageStats.numHarvests = 0;
   pageStats.lastCurrent = 0;
 
   TransTableL::ReleaseTT();
@@ -428,19 +463,15 @@ double TransTableL::MemoryInUse() const
 TransTableL::winBlockType * TransTableL::GetNextCardBlock()
 {
   /*
-     Spaghetti code. The basic idea is that there is a pool of
-     pages. When a page runs out, we get a next pool. But we're
-     only allowed a certain maximum number, and calloc might also
-     fail before then. We have a default number of pages that
-     we don't give back voluntarily once we have acquired them,
-     but we give back anything more than that at the end of each
-     hand. If this overall mechanism fails, then we try to harvest
-     old entries scattered throughout the TT memory. If we get
-     enough for a "page", then we use that single page, and if
-     that runs out later, we try to harvest some more, starting
-     where we left off harvesting last time. If the harvesting also
-     fails, then we reset whatever TT memory we do have, and we
-     continue with that.
+     The basic idea is that there is a pool of pages. When a page
+     runs out, we get a next pool. But we're only allowed a certain
+     maximum number, and calloc might also fail before then. We
+     have a default number of pages that we don't give back
+     voluntarily once we have acquired them, but we give back
+     anything more than that at the end of each hand. Once we
+     can't get any more pages, every further block is reclaimed
+     from the TT itself by a clock sweep, one block at a time.
+     So the table stays full, but we never stop to clean it up.
   */
 
   if (poolp == nullptr)
@@ -466,23 +497,10 @@ TransTableL::winBlockType * TransTableL::GetNextCardBlock()
 
     return nextBlockp++;
   }
-  else if (memState == FROM_HARVEST)
+  else if (memState == FROM_CLOCK)
   {
     // Not allowed to get more memory, so reuse old one.
-    int n = harvested.nextBlockNo;
-    if (n == BLOCKS_PER_PAGE)
-    {
-      if (! TransTableL::Harvest())
-      {
-        TransTableL::ResetMemory(TT_RESET_UNKNOWN);
-        poolp->nextBlockNo++;
-        return nextBlockp++;
-      }
-      n = 0;
-    }
-
-    harvested.nextBlockNo++;
-    return harvested.list[n];
+    return TransTableL::Reclaim();
   }
   else if (poolp->nextBlockNo == BLOCKS_PER_PAGE)
   {
@@ -497,17 +515,9 @@ TransTableL::winBlockType * TransTableL::GetNextCardBlock()
     }
     else if (pagesCurrent == pagesMaximum)
     {
-      // Have to try to reclaim memory.
-      if (! TransTableL::Harvest())
-      {
-        TransTableL::ResetMemory(TT_RESET_UNKNOWN);
-        poolp->nextBlockNo++;
-        return nextBlockp++;
-      }
-
-      memState = FROM_HARVEST;
-      harvested.nextBlockNo++;
-      return harvested.list[0];
+      // Have to reclaim memory from now on.
+      memState = FROM_CLOCK;
+      return TransTableL::Reclaim();
     }
     else
     {
@@ -517,18 +527,9 @@ TransTableL::winBlockType * TransTableL::GetNextCardBlock()
 
       if (newpoolp == nullptr)
       {
-        // Unexpected, but try harvesting before we give up
-        // and start over.
-        if (! TransTableL::Harvest())
-        {
-          TransTableL::ResetMemory(TT_RESET_UNKNOWN);
-          poolp->nextBlockNo++;
-          return nextBlockp++;
-        }
-
-        memState = FROM_HARVEST;
-        harvested.nextBlockNo++;
-        return harvested.list[0];
+        // Unexpected, but we can live with the memory we have.
+        memState = FROM_CLOCK;
+        return TransTableL::Reclaim();
       }
 
       newpoolp->list = static_cast<winBlockType *>
@@ -536,16 +537,9 @@ TransTableL::winBlockType * TransTableL::GetNextCardBlock()
 
       if (! newpoolp->list)
       {
-        if (! TransTableL::Harvest())
-        {
-          TransTableL::ResetMemory(TT_RESET_UNKNOWN);
-          poolp->nextBlockNo++;
-          return nextBlockp++;
-        }
-
-        memState = FROM_HARVEST;
-        harvested.nextBlockNo++;
-        return harvested.list[0];
+        free(newpoolp);
+        memState = FROM_CLOCK;
+        return TransTableL::Reclaim();
       }
 
       newpoolp->nextBlockNo = 1;
@@ -568,68 +562,110 @@ TransTableL::winBlockType * TransTableL::GetNextCardBlock()
 }
 
 
-bool TransTableL::Harvest()
+int TransTableL::ClockChances(const int trick) const
 {
-  distHashType * rootptr = TTroot[harvestTrick][harvestHand];
-  distHashType * ptr;
-  winBlockType * bp;
+  // Entries with more tricks to go are more expensive to
+  // recompute, so they survive more passes of the clock.
+  return 1 + trick / CLOCK_TRICKS_PER_CHANCE;
+}
+
+
+void TransTableL::AdvanceClock()
+{
+  clockSlot = 0;
+  if (++clockHash < 256)
+    return;
+
+  clockHash = 0;
+  if (++clockHand < DDS_HANDS)
+    return;
+
+  clockHand = 0;
+  if (++clockTrick == TT_TRICKS)
+    clockTrick = 0;
+}
+
+
+TransTableL::winBlockType * TransTableL::Evict(
+  const int trick,
+  const int hand,
+  distHashType * dp,
+  const int slot)
+{
+  winBlockType * bp = dp->list[slot].posBlock;
+
+  // Swap the last element down.
+  if (slot != dp->nextNo - 1)
+    dp->list[slot] = dp->list[ dp->nextNo - 1 ];
+
+  dp->nextNo--;
+  dp->nextWriteNo = dp->nextNo;
+
+  // We might be in the middle of a recursion that wants to
+  // Add to this block once it returns. Make it drop that entry.
+  if (lastBlockSeen[trick][hand] == bp)
+    lastBlockSeen[trick][hand] = nullptr;
+
+  stats.reclaims++;
+  return bp;
+}
 
-  int trick = harvestTrick;
-  int hand = harvestHand;
-  int hash, suit, hno = 0;
 
-  while (1)
+TransTableL::winBlockType * TransTableL::Reclaim()
+{
+  /*
+     Second-chance clock over all [trick][hand][hash] buckets.
+     A block gets ClockChances(trick) lives whenever it is used,
+     and it loses one every time the clock passes over it. The
+     first block without any lives left is reused. In order to
+     keep the cost per block bounded, we only look at CLOCK_STEPS
+     blocks. If none of them has run out of lives, we reuse the
+     one with the fewest lives left among those we saw.
+  */
+
+  distHashType * victimp = nullptr;
+  int victimTrick = 0, victimHand = 0, victimSlot = 0;
+  int victimChances = 0;
+
+  const int numBuckets = TT_TRICKS * DDS_HANDS * 256;
+  int steps = 0, emptyBuckets = 0;
+
+  while (steps < CLOCK_STEPS || victimp == nullptr)
   {
-    for (hash = 0; hash < 256; hash++)
+    distHashType * dp = &TTroot[clockTrick][clockHand][clockHash];
+    if (clockSlot >= dp->nextNo)
     {
-      ptr = &rootptr[hash];
-      for (suit = ptr->nextNo - 1; suit >= 0; suit--)
+      if (++emptyBuckets > numBuckets && victimp == nullptr)
       {
-        bp = ptr->list[suit].posBlock;
-        if (timestamp - bp->timestampRead > HARVEST_AGE)
-        {
-          bp->nextMatchNo = 0;
-          bp->nextWriteNo = 0;
-          bp->timestampRead = timestamp;
-          harvested.list[hno] = bp;
-
-          // Swap the last element down.
-          if (suit != ptr->nextNo - 1)
-            ptr->list[suit] = ptr->list[ ptr->nextNo - 1 ];
-
-          ptr->nextNo--;
-          ptr->nextWriteNo = ptr->nextNo;
-
-          if (++hno == BLOCKS_PER_PAGE)
-          {
-            if (++harvestHand >= DDS_HANDS)
-            {
-              // Skip rest of this [trick][hand] for simplicity.
-              harvestHand = 0;
-              if (--harvestTrick < 0)
-                harvestTrick = FIRST_HARVEST_TRICK;
-            }
-
-            harvested.nextBlockNo = 0;
-            pageStats.numHarvests++;
-            return true;
-          }
-        }
+        // Cannot happen as long as all blocks are in the TT.
+        TransTableL::ResetMemory(TT_RESET_MEMORY_EXHAUSTED);
+        poolp->nextBlockNo++;
+        return nextBlockp++;
       }
+
+      TransTableL::AdvanceClock();
+      continue;
     }
 
-    if (++harvestHand >= DDS_HANDS)
+    winBlockType * bp = dp->list[clockSlot].posBlock;
+    if (bp->chances <= 0)
+      return TransTableL::Evict(clockTrick, clockHand, dp, clockSlot);
+
+    if (victimp == nullptr || bp->chances < victimChances)
     {
-      harvestHand = 0;
-      if (--harvestTrick < 0)
-        harvestTrick = FIRST_HARVEST_TRICK;
+      victimp = dp;
+      victimTrick = clockTrick;
+      victimHand = clockHand;
+      victimSlot = clockSlot;
+      victimChances = bp->chances;
     }
 
-    if (harvestTrick == trick && harvestHand == hand)
-      return false;
-
-    rootptr = TTroot[harvestTrick][harvestHand];
+    bp->chances--;
+    clockSlot++;
+    steps++;
   }
+
+  return TransTableL::Evict(victimTrick, victimHand, victimp, victimSlot);
 }
 
 
@@ -667,6 +703,38 @@ int TransTableL::hash8(const int handDist[]) const
 }
 
 
+TransTableL::distHashType * TransTableL::Bucket(
+  const int trick,
+  const int hand,
+  const int handDist[]) const
+{
+  // Only needs the hash, not the full suit-length key.
+  return &TTroot[trick][hand][hash8(handDist)];
+}
+
+
+void TransTableL::Prefetch(
+  const int trick,
+  const int hand,
+  const unsigned short aggrTarget[],
+  const int handDist[])
+{
+  // The position is usually matched within the first few
+  // suit-length entries of its bucket, so the start of the
+  // bucket is what Lookup will wait for. The aggr lines are
+  // scattered over 640 KB and are the other likely misses.
+
+  distHashType const * dp = TransTableL::Bucket(trick, hand, handDist);
+  TT_PREFETCH(dp);
+  TT_PREFETCH(&dp->list[3]);
+
+  TT_PREFETCH(aggr[ aggrTarget[0] ].aggrBytes[0]);
+  TT_PREFETCH(aggr[ aggrTarget[1] ].aggrBytes[1]);
+  TT_PREFETCH(aggr[ aggrTarget[2] ].aggrBytes[2]);
+  TT_PREFETCH(aggr[ aggrTarget[3] ].aggrBytes[3]);
+}
+
+
 nodeCardsType * TransTableL::Lookup(
   const int tricks,
   const int hand,
@@ -675,6 +743,8 @@ nodeCardsType * TransTableL::Lookup(
   const int limit,
   bool& lowerFlag)
 {
+  stats.lookups++;
+
   // First look up distribution.
   long long suitLengths =
     (static_cast<long long>(handDist[0]) << 36) |
@@ -682,13 +752,15 @@ nodeCardsType * TransTableL::Lookup(
     (static_cast<long long>(handDist[2]) << 12) |
     (static_cast<long long>(handDist[3]) );
 
-  int hashkey = hash8(handDist);
-
   bool empty;
-  lastBlockSeen[tricks][hand] =
-    LookupSuit(&TTroot[tricks][hand][hashkey], suitLengths, empty);
+  winBlockType * bp = LookupSuit(
+    TransTableL::Bucket(tricks, hand, handDist), suitLengths, empty);
+  lastBlockSeen[tricks][hand] = bp;
   if (empty)
+  {
+    bp->chances = TransTableL::ClockChances(tricks);
     return nullptr;
+  }
 
   // If that worked, look up cards.
   unsigned * ab0 = aggr[ aggrTarget[0] ].aggrBytes[0];
@@ -700,10 +772,16 @@ nodeCardsType * TransTableL::Lookup(
   TTentry.topSet1 = ab0[0] | ab1[0] | ab2[0] | ab3[0];
   TTentry.topSet2 = ab0[1] | ab1[1] | ab2[1] | ab3[1];
   TTentry.topSet3 = ab0[2] | ab1[2] | ab2[2] | ab3[2];
-  TTentry.topSet4 = ab0[3] | ab1[3] | ab2[3] | ab3[3];
 
-  return TransTableL::LookupCards(TTentry,
-    lastBlockSeen[tricks][hand], limit, lowerFlag);
+  nodeCardsType * nodep =
+    TransTableL::LookupCards(TTentry, bp, limit, lowerFlag);
+  if (nodep)
+  {
+    stats.hits++;
+    bp->chances = TransTableL::ClockChances(tricks);
+  }
+
+  return nodep;
 }
 
 
@@ -754,7 +832,6 @@ TransTableL::winBlockType * TransTableL::LookupSuit(
     winBlockType * bp = GetNextCardBlock();
     m = dp->nextWriteNo++;
     dp->list[m].posBlock = bp;
-    dp->list[m].posBlock->timestampRead = timestamp;
     dp->nextNo++;
   }
 
@@ -786,34 +863,36 @@ nodeCardsType * TransTableL::LookupCards(
 
   for (int i = n; i >= 0; i--, wp--)
   {
-    if ((wp->topSet1 ^ search.topSet1) & wp->topMask1)
+    unsigned const * mh = topMaskHigh[wp->maskIndex >> 8];
+    unsigned const * ml = topMaskLow[wp->maskIndex & 0xff];
+
+    if ((wp->topSet1 ^ search.topSet1) & (mh[0] | ml[0]))
       continue;
 
     if (wp->lastMaskNo != 1)
     {
-      if ((wp->topSet2 ^ search.topSet2) & wp->topMask2)
+      if ((wp->topSet2 ^ search.topSet2) & (mh[1] | ml[1]))
         continue;
 
       if (wp->lastMaskNo != 2)
       {
-        if ((wp->topSet3 ^ search.topSet3) & wp->topMask3)
+        if ((wp->topSet3 ^ search.topSet3) & (mh[2] | ml[2]))
           continue;
       }
     }
 
     // Check bounds.
-    nodeCardsType * nodep = &wp->first;
-    if (nodep->lbound > limit)
+    if (wp->first.lbound > limit)
     {
-      bp->timestampRead = ++timestamp;
       lowerFlag = true;
-      return nodep;
+      TransTableL::MatchToNode(* wp, lookupNode);
+      return &lookupNode;
     }
-    else if (nodep->ubound <= limit)
+    else if (wp->first.ubound <= limit)
     {
-      bp->timestampRead = ++timestamp;
       lowerFlag = false;
-      return nodep;
+      TransTableL::MatchToNode(* wp, lookupNode);
+      return &lookupNode;
     }
   }
 
@@ -822,33 +901,35 @@ nodeCardsType * TransTableL::LookupCards(
 
   for (int i = n2; i > n; i--, wp--)
   {
-    if ((wp->topSet1 ^ search.topSet1) & wp->topMask1)
+    unsigned const * mh = topMaskHigh[wp->maskIndex >> 8];
+    unsigned const * ml = topMaskLow[wp->maskIndex & 0xff];
+
+    if ((wp->topSet1 ^ search.topSet1) & (mh[0] | ml[0]))
       continue;
 
     if (wp->lastMaskNo != 1)
     {
-      if ((wp->topSet2 ^ search.topSet2) & wp->topMask2)
+      if ((wp->topSet2 ^ search.topSet2) & (mh[1] | ml[1]))
         continue;
 
       if (wp->lastMaskNo != 2)
       {
-        if ((wp->topSet3 ^ search.topSet3) & wp->topMask3)
+        if ((wp->topSet3 ^ search.topSet3) & (mh[2] | ml[2]))
           continue;
       }
     }
 
-    nodeCardsType * nodep = &wp->first;
-    if (nodep->lbound > limit)
+    if (wp->first.lbound > limit)
     {
       lowerFlag = true;
-      bp->timestampRead = ++timestamp;
-      return nodep;
+      TransTableL::MatchToNode(* wp, lookupNode);
+      return &lookupNode;
     }
-    else if (nodep->ubound <= limit)
+    else if (wp->first.ubound <= limit)
     {
       lowerFlag = false;
-      bp->timestampRead = ++timestamp;
-      return nodep;
+      TransTableL::MatchToNode(* wp, lookupNode);
+      return &lookupNode;
     }
   }
 
@@ -856,6 +937,21 @@ nodeCardsType * TransTableL::LookupCards(
 }
 
 
+void TransTableL::MatchToNode(
+  const winMatchType& wp,
+  nodeCardsType& node) const
+{
+  node.ubound = wp.first.ubound;
+  node.lbound = wp.first.lbound;
+  node.bestMoveSuit = wp.first.bestMoveSuit;
+  node.bestMoveRank = wp.first.bestMoveRank;
+
+  for (int ss = 0; ss < DDS_SUITS; ss++)
+    node.leastWin[ss] = static_cast<char>
+      (15 - ((wp.maskIndex >> (12 - 4 * ss)) & 0xf));
+}
+
+
 void TransTableL::CreateOrUpdate(
   winBlockType * bp,
   const winMatchType& search,
@@ -871,13 +967,12 @@ void TransTableL::CreateOrUpdate(
 
   for (int i = 0; i < n; i++, wp++)
   {
-    if (wp->xorSet != search.xorSet ) continue;
     if (wp->maskIndex != search.maskIndex) continue;
     if (wp->topSet1 != search.topSet1 ) continue;
     if (wp->topSet2 != search.topSet2 ) continue;
     if (wp->topSet3 != search.topSet3 ) continue;
 
-    nodeCardsType& node = wp->first;
+    nodeBoundsType& node = wp->first;
     if (search.first.lbound > node.lbound)
       node.lbound = search.first.lbound;
     if (search.first.ubound < node.ubound)
@@ -925,19 +1020,19 @@ void TransTableL::Add(
   }
 
   unsigned * ab[DDS_SUITS];
-  unsigned * mb[DDS_SUITS];
-  char low[DDS_SUITS];
+  int low[DDS_SUITS];
   unsigned short int ag;
   int w;
   winMatchType TTentry;
 
-  // Inefficient, as it also copies leastWin.
-  // In fact I'm not quite happy with the treatment of
-  // leastWin in general.
+  // leastWin is not stored, as it follows from maskIndex.
 
-  TTentry.first = first;
+  TTentry.first.ubound = first.ubound;
+  TTentry.first.lbound = first.lbound;
+  TTentry.first.bestMoveSuit = first.bestMoveSuit;
+  TTentry.first.bestMoveRank = first.bestMoveRank;
 
-  TTentry.xorSet = 0;
+  int maxCards = 0;
 
   for (int ss = 0; ss < DDS_SUITS; ss++)
   {
@@ -945,9 +1040,7 @@ void TransTableL::Add(
     if (w == 0)
     {
       ab[ss] = aggr[0].aggrBytes[ss];
-      mb[ss] = maskBytes[0][ss];
       low[ss] = 15;
-      TTentry.first.leastWin[ss] = 0;
     }
     else
     {
@@ -955,11 +1048,10 @@ void TransTableL::Add(
       ag = static_cast<unsigned short>(aggrTarget[ss] & (-w));
 
       ab[ss] = aggr[ag].aggrBytes[ss];
-      mb[ss] = maskBytes[ag][ss];
-      low[ss] = static_cast<char>(TTlowestRank[ag]);
+      low[ss] = TTlowestRank[ag];
 
-      TTentry.first.leastWin[ss] = 15 - low[ss];
-      TTentry.xorSet ^= aggr[ag].aggrRanks[ss];
+      if (15 - low[ss] > maxCards)
+        maxCards = 15 - low[ss];
     }
   }
 
@@ -969,27 +1061,24 @@ void TransTableL::Add(
   TTentry.topSet1 = ab[0][0] | ab[1][0] | ab[2][0] | ab[3][0];
   TTentry.topSet2 = ab[0][1] | ab[1][1] | ab[2][1] | ab[3][1];
   TTentry.topSet3 = ab[0][2] | ab[1][2] | ab[2][2] | ab[3][2];
-  TTentry.topSet4 = ab[0][3] | ab[1][3] | ab[2][3] | ab[3][3];
-
-  TTentry.topMask1 = mb[0][0] | mb[1][0] | mb[2][0] | mb[3][0];
-  TTentry.topMask2 = mb[0][1] | mb[1][1] | mb[2][1] | mb[3][1];
-  TTentry.topMask3 = mb[0][2] | mb[1][2] | mb[2][2] | mb[3][2];
-  TTentry.topMask4 = mb[0][3] | mb[1][3] | mb[2][3] | mb[3][3];
 
-  TTentry.maskIndex =
-    (low[0] << 12) | (low[1] << 8) | (low[2] << 4) | low[3];
+  TTentry.maskIndex = static_cast<unsigned short>(
+    (low[0] << 12) | (low[1] << 8) | (low[2] << 4) | low[3]);
 
-  if (TTentry.topMask2 == 0)
+  if (maxCards <= 4)
     TTentry.lastMaskNo = 1;
-  else if (TTentry.topMask3 == 0)
+  else if (maxCards <= 8)
     TTentry.lastMaskNo = 2;
-  else if (TTentry.topMask4 == 0)
+  else if (maxCards <= 12)
     TTentry.lastMaskNo = 3;
   else
     TTentry.lastMaskNo = 4;
 
-  TransTableL::CreateOrUpdate(lastBlockSeen[tricks][hand],
-    TTentry, flag);
+  stats.stores++;
+
+  winBlockType * bp = lastBlockSeen[tricks][hand];
+  bp->chances = TransTableL::ClockChances(tricks);
+  TransTableL::CreateOrUpdate(bp, TTentry, flag);
 }
 
 
@@ -1003,14 +1092,19 @@ void TransTableL::PrintMatch(
   for (unsigned i = 0; i < DDS_HANDS; i++)
     hands[i].resize(DDS_SUITS);
 
-  TransTableL::SetToPartialHands(wp.topSet1, wp.topMask1, 14, 4, hands);
-  TransTableL::SetToPartialHands(wp.topSet2, wp.topMask2, 10, 4, hands);
-  TransTableL::SetToPartialHands(wp.topSet3, wp.topMask3, 6, 4, hands);
-  TransTableL::SetToPartialHands(wp.topSet4, wp.topMask4, 2, 1, hands);
+  // The 13th card of a suit is not stored, so it is not shown.
+  unsigned const * mh = topMaskHigh[wp.maskIndex >> 8];
+  unsigned const * ml = topMaskLow[wp.maskIndex & 0xff];
+
+  TransTableL::SetToPartialHands(wp.topSet1, mh[0] | ml[0], 14, 4, hands);
+  TransTableL::SetToPartialHands(wp.topSet2, mh[1] | ml[1], 10, 4, hands);
+  TransTableL::SetToPartialHands(wp.topSet3, mh[2] | ml[2], 6, 4, hands);
 
   TransTableL::DumpHands(fout, hands, lengths);
 
-  TransTableL::PrintNodeValues(fout, wp.first);
+  nodeCardsType node;
+  TransTableL::MatchToNode(wp, node);
+  TransTableL::PrintNodeValues(fout, node);
 }
 
 
@@ -1536,7 +1630,6 @@ void TransTableL::PrintEntriesDistAndCards(
   TTentry.topSet1 = ab0[0] | ab1[0] | ab2[0] | ab3[0];
   TTentry.topSet2 = ab0[1] | ab1[1] | ab2[1] | ab3[1];
   TTentry.topSet3 = ab0[2] | ab1[2] | ab2[2] | ab3[2];
-  TTentry.topSet4 = ab0[3] | ab1[3] | ab2[3] | ab3[3];
 
   int matchNo = 1;
   int n = bp->nextMatchNo - 1;
@@ -1544,17 +1637,20 @@ void TransTableL::PrintEntriesDistAndCards(
 
   for (int i = n; i >= 0; i--, wp--)
   {
-    if ((wp->topSet1 ^ TTentry.topSet1) & wp->topMask1)
+    unsigned const * mh = topMaskHigh[wp->maskIndex >> 8];
+    unsigned const * ml = topMaskLow[wp->maskIndex & 0xff];
+
+    if ((wp->topSet1 ^ TTentry.topSet1) & (mh[0] | ml[0]))
       continue;
 
     if (wp->lastMaskNo != 1)
     {
-      if ((wp->topSet2 ^ TTentry.topSet2) & wp->topMask2)
+      if ((wp->topSet2 ^ TTentry.topSet2) & (mh[1] | ml[1]))
         continue;
 
       if (wp->lastMaskNo != 2)
       {
-        if ((wp->topSet3 ^ TTentry.topSet3) & wp->topMask3)
+        if ((wp->topSet3 ^ TTentry.topSet3) & (mh[2] | ml[2]))
           continue;
       }
     }
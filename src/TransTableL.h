@@ -31,8 +31,8 @@ using namespace std;
 #define BLOCKS_PER_PAGE 1000
 #define DISTS_PER_ENTRY 32
 #define BLOCKS_PER_ENTRY 125
-#define FIRST_HARVEST_TRICK 8
-#define HARVEST_AGE 10000
+#define CLOCK_STEPS 32
+#define CLOCK_TRICKS_PER_CHANCE 4
 
 #define TT_BYTES 4
 #define TT_TRICKS 12
@@ -46,21 +46,27 @@ class TransTableL: public TransTable
 {
   private:
 
-    struct winMatchType // 52 bytes
+    struct nodeBoundsType // 4 bytes
     {
-      unsigned xorSet;
-      unsigned topSet1 , topSet2 , topSet3 , topSet4 ;
-      unsigned topMask1, topMask2, topMask3, topMask4;
-      int maskIndex;
-      int lastMaskNo;
-      nodeCardsType first;
+      char ubound;
+      char lbound;
+      char bestMoveSuit;
+      char bestMoveRank;
     };
 
-    struct winBlockType // 6508 bytes when BLOCKS_PER_ENTRY == 125
+    struct winMatchType // 20 bytes
+    {
+      unsigned topSet1, topSet2, topSet3;
+      unsigned short maskIndex;
+      char lastMaskNo;
+      nodeBoundsType first;
+    };
+
+    struct winBlockType // 2512 bytes when BLOCKS_PER_ENTRY == 125
     {
       int nextMatchNo;
       int nextWriteNo;
-      int timestampRead;
+      int chances;
       winMatchType list[BLOCKS_PER_ENTRY];
     };
 
@@ -96,20 +102,13 @@ class TransTableL: public TransTable
       int numResets;
       int numCallocs;
       int numFrees;
-      int numHarvests;
       int lastCurrent;
     };
 
-    struct harvestedType // 16 bytes
-    {
-      int nextBlockNo;
-      winBlockType * list [BLOCKS_PER_PAGE];
-    };
-
     enum memStateType
     {
       FROM_POOL,
-      FROM_HARVEST
+      FROM_CLOCK
     };
 
     // Private data for the full memory version.
@@ -119,8 +118,11 @@ class TransTableL: public TransTable
     int pagesCurrent;
     int pagesMaximum;
 
-    int harvestTrick;
-    int harvestHand;
+    // Position of the replacement clock hand.
+    int clockTrick;
+    int clockHand;
+    int clockHash;
+    int clockSlot;
 
     pageStatsType pageStats;
 
@@ -139,9 +141,10 @@ class TransTableL: public TransTable
     // The pool of card entries for a given suit distribution.
     poolType * poolp;
     winBlockType * nextBlockp;
-    harvestedType harvested;
 
-    int timestamp;
+    // The node that Lookup hands out, expanded from a winMatchType.
+    nodeCardsType lookupNode;
+
     int TTInUse;
 
 
@@ -153,6 +156,11 @@ class TransTableL: public TransTable
 
     int hash8(const int handDist[]) const;
 
+    distHashType * Bucket(
+      const int trick,
+      const int hand,
+      const int handDist[]) const;
+
     winBlockType * GetNextCardBlock();
 
     winBlockType * LookupSuit(
@@ -160,6 +168,10 @@ class TransTableL: public TransTable
       const long long key,
       bool& empty);
 
+    void MatchToNode(
+      const winMatchType& wp,
+      nodeCardsType& node) const;
+
     nodeCardsType * LookupCards(
       const winMatchType& search,
       winBlockType * bp,
@@ -171,7 +183,17 @@ class TransTableL: public TransTable
       const winMatchType& search,
       const bool flag);
 
-    bool Harvest();
+    int ClockChances(const int trick) const;
+
+    void AdvanceClock();
+
+    winBlockType * Evict(
+      const int trick,
+      const int hand,
+      distHashType * dp,
+      const int slot);
+
+    winBlockType * Reclaim();
 
     // Debug functions from here on.
 
@@ -312,6 +334,12 @@ class TransTableL: public TransTable
       const nodeCardsType& first,
       const bool flag);
 
+    void Prefetch(
+      const int trick,
+      const int hand,
+      const unsigned short aggrTarget[],
+      const int handDist[]);
+
     void PrintSuits(
       ofstream& fout,
       const int trick,
@@ -13,11 +13,18 @@
 #include "debug.h"
 
 
-#define NSIZE 50000
-#define WSIZE 50000
-#define NINIT 60000
-#define WINIT 170000
-#define LSIZE 200 // Per trick and first hand
+// The arenas share maxmem in these proportions, which are roughly
+// those in which a full search consumes them.
+#define WIN_SHARE 17
+#define NODE_SHARE 2
+#define LEN_SHARE 1
+#define SUM_SHARE (WIN_SHARE + NODE_SHARE + LEN_SHARE)
+
+// One Add uses at most this many entries of each arena, so there
+// is always room to finish the path that hits the limit.
+#define ARENA_SLACK DDS_SUITS
+
+#define ROOT_NODES (13 * DDS_HANDS)
 
 
 static bool _constantsSet = false;
@@ -33,6 +40,10 @@ TransTableS::TransTableS()
   }
 
   TTInUse = 0;
+  winCards = nullptr;
+  nodeCards = nullptr;
+  posSearch = nullptr;
+  aggp = nullptr;
 }
 
 
@@ -114,236 +125,123 @@ void TransTableS::SetMemoryMaximum(const int megabytes)
 }
 
 
-void TransTableS::MakeTT()
+static unsigned RootIndex(
+  const int trick,
+  const int hand)
 {
-  int i;
-
-  if (!TTInUse)
-  {
-    TTInUse = 1;
-
-    summem = (WINIT + 1) * sizeof(winCardType) +
-             (NINIT + 1) * sizeof(nodeCardsType) +
-             (LSIZE + 1) * 52 * sizeof(posSearchTypeSmall);
-    wmem = static_cast<int>((WSIZE + 1) * sizeof(winCardType));
-    nmem = static_cast<int>((NSIZE + 1) * sizeof(nodeCardsType));
-
-    maxIndex = static_cast<int>(
-      (maxmem - summem) / ((WSIZE + 1) * sizeof(winCardType)));
-
-    pw = static_cast<winCardType **>(calloc(static_cast<unsigned int>(maxIndex + 1), sizeof(winCardType *)));
-    if (pw == NULL)
-      exit(1);
-
-    pn = static_cast<nodeCardsType **>(calloc(static_cast<unsigned int>(maxIndex + 1), sizeof(nodeCardsType *)));
-    if (pn == NULL)
-      exit(1);
-
-    for (int k = 1; k <= 13; k++)
-      for (int h = 0; h < DDS_HANDS; h++)
-      {
-        pl[k][h] = static_cast
-                   <posSearchTypeSmall **>(calloc(static_cast<unsigned int>(maxIndex + 1),
-                                             sizeof(posSearchTypeSmall *)));
-        if (pl[k][h] == NULL)
-          exit(1);
-      }
-
-    for (i = 0; i <= maxIndex; i++)
-    {
-      if (pw[i])
-        free(pw[i]);
-      pw[i] = NULL;
-    }
-
-    for (i = 0; i <= maxIndex; i++)
-    {
-      if (pn[i])
-        free(pn[i]);
-      pn[i] = NULL;
-    }
+  return static_cast<unsigned>(1 + (trick - 1) * DDS_HANDS + hand);
+}
 
-    for (int k = 1; k <= 13; k++)
-    {
-      for (int h = 0; h < DDS_HANDS; h++)
-      {
-        for (i = 0; i <= maxIndex; i++)
-        {
-          if (pl[k][h][i])
-            free(pl[k][h][i]);
-          pl[k][h][i] = NULL;
-        }
-      }
-    }
 
-    pw[0] = static_cast<winCardType *>(calloc(WINIT + 1, sizeof(winCardType)));
-    if (pw[0] == NULL)
-      exit(1);
+void TransTableS::MakeTT()
+{
+  if (TTInUse)
+    return;
 
-    pn[0] = static_cast<nodeCardsType *>(calloc(NINIT + 1, sizeof(nodeCardsType)));
-    if (pn[0] == NULL)
-      exit(1);
+  TTInUse = 1;
 
-    for (int k = 1; k <= 13; k++)
-      for (int h = 0; h < DDS_HANDS; h++)
-      {
-        pl[k][h][0] = static_cast<posSearchTypeSmall *>(calloc((LSIZE + 1),
-                      sizeof(posSearchTypeSmall)));
-        if (pl[k][h][0] == NULL)
-          exit(1);
-      }
+  // The arenas are reserved up front and never grow, so all
+  // links can be 32-bit indices, and a reset only has to rewind
+  // the bump counters. Pages that are never touched are not
+  // actually committed on most systems.
+  const unsigned long long share = maxmem / SUM_SHARE;
 
-    aggp = static_cast<ttAggrType *>(calloc(8192, sizeof(ttAggrType)));
-    if (aggp == NULL)
-      exit(1);
+  winSetSize = static_cast<unsigned>(
+    WIN_SHARE * share / sizeof(winCardType));
+  nodeSetSize = static_cast<unsigned>(
+    NODE_SHARE * share / sizeof(nodeCardsType));
+  lenSetSize = static_cast<unsigned>(
+    LEN_SHARE * share / sizeof(posSearchTypeSmall));
 
-    InitTT();
+  if (lenSetSize < ROOT_NODES + 2)
+    lenSetSize = ROOT_NODES + 2;
 
-    for (int k = 1; k <= 13; k++)
-      aggrLenSets[k] = 0;
-    statsResets.noOfResets = 0;
-    for (int k = 0; k <= 5; k++)
-      statsResets.aggrResets[k] = 0;
+  winCards = static_cast<winCardType *>(
+    malloc((winSetSize + ARENA_SLACK) * sizeof(winCardType)));
+  nodeCards = static_cast<nodeCardsType *>(
+    malloc((nodeSetSize + ARENA_SLACK) * sizeof(nodeCardsType)));
+  posSearch = static_cast<posSearchTypeSmall *>(
+    malloc((lenSetSize + ARENA_SLACK) * sizeof(posSearchTypeSmall)));
 
-  }
+  if (winCards == nullptr || nodeCards == nullptr || posSearch == nullptr)
+    exit(1);
 
-  return;
-}
+  allocmem =
+    (winSetSize + ARENA_SLACK) * sizeof(winCardType) +
+    (nodeSetSize + ARENA_SLACK) * sizeof(nodeCardsType) +
+    (lenSetSize + ARENA_SLACK) * sizeof(posSearchTypeSmall);
 
+  aggp = static_cast<ttAggrType *>(calloc(8192, sizeof(ttAggrType)));
+  if (aggp == nullptr)
+    exit(1);
 
-void TransTableS::Wipe()
-{
-  int m;
-
-  for (m = 1; m <= wcount; m++)
-  {
-    if (pw[m])
-      free(pw[m]);
-    pw[m] = NULL;
-  }
-  for (m = 1; m <= ncount; m++)
-  {
-    if (pn[m])
-      free(pn[m]);
-    pn[m] = NULL;
-  }
+  TransTableS::InitTT();
 
   for (int k = 1; k <= 13; k++)
-  {
-    for (int h = 0; h < DDS_HANDS; h++)
-    {
-      for (m = 1; m <= lcount[k][h]; m++)
-      {
-        if (pl[k][h][m])
-          free(pl[k][h][m]);
-        pl[k][h][m] = NULL;
-      }
-    }
-  }
-
-  allocmem = summem;
-
-  return;
+    aggrLenSets[k] = 0;
+  statsResets.noOfResets = 0;
+  for (int k = 0; k <= 5; k++)
+    statsResets.aggrResets[k] = 0;
 }
 
 
-
 void TransTableS::InitTT()
 {
-  winSetSizeLimit = WINIT;
-  nodeSetSizeLimit = NINIT;
-  allocmem = (WINIT + 1) * sizeof(winCardType);
-  allocmem += (NINIT + 1) * sizeof(nodeCardsType);
-  allocmem += (LSIZE + 1) * 52 * sizeof(posSearchTypeSmall);
-  winCards = pw[0];
-  nodeCards = pn[0];
-  wcount = 0;
-  ncount = 0;
-
-  nodeSetSize = 0;
-  winSetSize = 0;
+  winSetNext = 1;
+  nodeSetNext = 1;
+  lenSetNext = 1 + ROOT_NODES;
 
   clearTTflag = false;
-  windex = -1;
 
   for (int k = 1; k <= 13; k++)
+  {
     for (int h = 0; h < DDS_HANDS; h++)
     {
-      posSearch[k][h] = pl[k][h][0];
-      lenSetInd[k][h] = 0;
-      lcount[k][h] = 0;
+      posSearchTypeSmall * rootp = &posSearch[RootIndex(k, h)];
+      rootp->suitLengths = 0;
+      rootp->posSearchPoint = 0;
+      rootp->left = 0;
+      rootp->right = 0;
     }
+  }
 }
 
 
 void TransTableS::ResetMemory(const TTresetReason reason)
 {
-  Wipe();
+  if (! TTInUse)
+    return;
 
-  InitTT();
+  TransTableS::InitTT();
 
-  for (int k = 1; k <= 13; k++)
-  {
-    for (int h = 0; h < DDS_HANDS; h++)
-    {
-      rootnp[k][h] = &(posSearch[k][h][0]);
-      posSearch[k][h][0].suitLengths = 0;
-      posSearch[k][h][0].posSearchPoint = NULL;
-      posSearch[k][h][0].left = NULL;
-      posSearch[k][h][0].right = NULL;
-
-      lenSetInd[k][h] = 1;
-    }
-  }
+  stats.resets[reason]++;
 
 #if defined(DDS_TT_STATS)
   statsResets.noOfResets++;
   statsResets.aggrResets[reason]++;
-#else
-  UNUSED(reason);
 #endif
 
   return;
 }
 
+
 void TransTableS::ReturnAllMemory()
 {
-
   if (!TTInUse)
     return;
   TTInUse = 0;
 
-  Wipe();
+  free(winCards);
+  winCards = nullptr;
 
-  if (pw[0])
-    free(pw[0]);
-  pw[0] = NULL;
+  free(nodeCards);
+  nodeCards = nullptr;
 
-  if (pn[0])
-    free(pn[0]);
-  pn[0] = NULL;
+  free(posSearch);
+  posSearch = nullptr;
 
-  for (int k = 1; k <= 13; k++)
-  {
-    for (int h = 0; h < DDS_HANDS; h++)
-    {
-      if (pl[k][h][0])
-        free(pl[k][h][0]);
-      pl[k][h][0] = NULL;
-    }
-  }
-
-  if (pw)
-    free(pw);
-  pw = NULL;
-
-  if (pn)
-    free(pn);
-  pn = NULL;
-
-  if (aggp)
-    free(aggp);
-  aggp = NULL;
+  free(aggp);
+  aggp = nullptr;
 
   return;
 }
@@ -351,9 +249,15 @@ void TransTableS::ReturnAllMemory()
 
 double TransTableS::MemoryInUse() const
 {
-  int ttMem = static_cast<int>(allocmem);
-  int aggrMem = 8192 * static_cast<int>(sizeof(ttAggrType));
-  return (ttMem + aggrMem) / static_cast<double>(1024.);
+  if (! TTInUse)
+    return 0.;
+
+  const unsigned long long ttMem =
+    winSetNext * sizeof(winCardType) +
+    nodeSetNext * sizeof(nodeCardsType) +
+    lenSetNext * sizeof(posSearchTypeSmall);
+  const unsigned long long aggrMem = 8192 * sizeof(ttAggrType);
+  return static_cast<double>(ttMem + aggrMem) / 1024.;
 }
 
 
@@ -366,21 +270,22 @@ nodeCardsType const * TransTableS::Lookup(
   bool& lowerFlag)
 {
   bool res;
-  posSearchTypeSmall * pp;
   int orderSet[DDS_SUITS];
   nodeCardsType const * cardsP;
 
+  stats.lookups++;
+
   suitLengths[trick] =
     (static_cast<long long>(handDist[0]) << 36) |
     (static_cast<long long>(handDist[1]) << 24) |
     (static_cast<long long>(handDist[2]) << 12) |
     (static_cast<long long>(handDist[3]));
 
-  pp = SearchLenAndInsert(rootnp[trick][hand],
-    suitLengths[trick], false, trick, hand, res);
+  const unsigned pp = SearchLenAndInsert(RootIndex(trick, hand),
+    suitLengths[trick], false, trick, res);
 
   /* Find node that fits the suit lengths */
-  if ((pp != NULL) && res)
+  if ((pp != 0) && res)
   {
     for (int ss = 0; ss < DDS_SUITS; ss++)
     {
@@ -388,14 +293,17 @@ nodeCardsType const * TransTableS::Lookup(
         aggp[aggrTarget[ss]].aggrRanks[ss];
     }
 
-    if (pp->posSearchPoint == NULL)
+    const unsigned wp = posSearch[pp].posSearchPoint;
+    if (wp == 0)
       cardsP = NULL;
     else
     {
-      cardsP = FindSOP(orderSet, limit, pp->posSearchPoint, lowerFlag);
+      cardsP = FindSOP(orderSet, limit, wp, lowerFlag);
 
       if (cardsP == NULL)
         return cardsP;
+
+      stats.hits++;
     }
   }
   else
@@ -414,6 +322,8 @@ void TransTableS::Add(
   const nodeCardsType& first,
   const bool flag)
 {
+  stats.stores++;
+
   BuildSOP(ourWinRanks, aggrTarget, first, suitLengths[tricks],
            tricks, hand, flag);
 
@@ -424,130 +334,35 @@ void TransTableS::Add(
 }
 
 
-void TransTableS::AddWinSet()
+unsigned TransTableS::AddWinSet()
 {
-  if (clearTTflag)
-  {
-    windex++;
-    winSetSize = windex;
-    winCards = &(temp_win[windex]);
-  }
-  else if (winSetSize >= winSetSizeLimit)
-  {
-    /* The memory chunk for the winCards structure will be exceeded. */
-    if (((allocmem + static_cast<unsigned long long>(wmem)) > maxmem) || (wcount >= maxIndex) ||
-        (winSetSize > SIMILARMAXWINNODES))
-    {
-      /* Already allocated memory plus needed allocation overshot maxmem */
-      windex++;
-      winSetSize = windex;
-      clearTTflag = true;
-      winCards = &(temp_win[windex]);
-    }
-    else
-    {
-      wcount++;
-      winSetSizeLimit = WSIZE;
-      pw[wcount] =
-        static_cast<winCardType *>(malloc((WSIZE + 1) * sizeof(winCardType)));
-      if (pw[wcount] == NULL)
-      {
-        clearTTflag = true;
-        windex++;
-        winSetSize = windex;
-        winCards = &(temp_win[windex]);
-      }
-      else
-      {
-        allocmem += (WSIZE + 1) * sizeof(winCardType);
-        winSetSize = 0;
-        winCards = pw[wcount];
-      }
-    }
-  }
-  else
-    winSetSize++;
-  return;
+  // Beyond the limit we still hand out the slack entries, so that
+  // the current path can be completed. Add then resets the table.
+  if (winSetNext >= winSetSize)
+    clearTTflag = true;
+  return winSetNext++;
 }
 
-void TransTableS::AddNodeSet()
-{
-  if (nodeSetSize >= nodeSetSizeLimit)
-  {
-    /* The memory chunk for the nodeCards structure will be exceeded. */
-    if (((allocmem + static_cast<unsigned long long>(nmem)) > maxmem) || (ncount >= maxIndex))
-    {
-      /* Already allocated memory plus needed allocation overshot maxmem */
-      clearTTflag = true;
-    }
-    else
-    {
-      ncount++;
-      nodeSetSizeLimit = NSIZE;
-      pn[ncount] =
-        static_cast<nodeCardsType *>(malloc((NSIZE + 1) * sizeof(nodeCardsType)));
-      if (pn[ncount] == NULL)
-      {
-        clearTTflag = true;
-      }
-      else
-      {
-        allocmem += (NSIZE + 1) * sizeof(nodeCardsType);
-        nodeSetSize = 0;
-        nodeCards = pn[ncount];
-      }
-    }
-  }
-  else
-    nodeSetSize++;
-  return;
-}
 
-void TransTableS::AddLenSet(
-  const int trick, 
-  const int firstHand)
+unsigned TransTableS::AddNodeSet()
 {
-  if (lenSetInd[trick][firstHand] < LSIZE)
-  {
-    lenSetInd[trick][firstHand]++;
-#if defined(DDS_TT_STATS)
-    aggrLenSets[trick]++;
-#endif
-    return;
-  }
-
-  // The memory chunk for the posSearchTypeSmall structure 
-  // will be exceeded.
-
-  const int incr = (LSIZE+1) * sizeof(posSearchTypeSmall);
-
-  if ((allocmem + incr > maxmem) || (lcount[trick][firstHand] >= maxIndex))
-  {
-    // Already allocated memory plus needed allocation overshot maxmem.
+  if (nodeSetNext >= nodeSetSize)
     clearTTflag = true;
-    return;
-  }
-
-  // Obtain another memory chunk LSIZE.
-
-  lcount[trick][firstHand]++;
-
-  pl[trick][firstHand][lcount[trick][firstHand]] =
-    static_cast<posSearchTypeSmall *>(malloc(incr));
+  return nodeSetNext++;
+}
 
-  if (pl[trick][firstHand][lcount[trick][firstHand]] == NULL)
-  {
-    clearTTflag = true;
-    return;
-  }
 
-  allocmem += incr;
-  lenSetInd[trick][firstHand] = 0;
-  posSearch[trick][firstHand] =
-    pl[trick][firstHand][lcount[trick][firstHand]];
+unsigned TransTableS::AddLenSet(const int trick)
+{
 #if defined(DDS_TT_STATS)
   aggrLenSets[trick]++;
+#else
+  UNUSED(trick);
 #endif
+
+  if (lenSetNext >= lenSetSize)
+    clearTTflag = true;
+  return lenSetNext++;
 }
 
 
@@ -586,8 +401,8 @@ void TransTableS::BuildSOP(
   }
 
   bool res;
-  posSearchTypeSmall * np = SearchLenAndInsert(
-    rootnp[tricks][firstHand], lengths, true, tricks, firstHand, res);
+  const unsigned np = SearchLenAndInsert(
+    RootIndex(tricks, firstHand), lengths, true, tricks, res);
 
   nodeCardsType * cardsP = BuildPath(
     winMask, 
@@ -628,7 +443,7 @@ nodeCardsType * TransTableS::BuildPath(
   const int lbound,
   const char bestMoveSuit,
   const char bestMoveRank,
-  posSearchTypeSmall * nodep,
+  const unsigned nodep,
   bool& result)
 {
   /* If result is TRUE, a new SOP has been created and BuildPath returns a
@@ -636,50 +451,46 @@ nodeCardsType * TransTableS::BuildPath(
   returns a pointer to the SOP */
 
   bool found;
-  winCardType * np, *p2, *nprev;
-  nodeCardsType *p;
+  unsigned np, p2, nprev;
 
-  np = nodep->posSearchPoint;
-  nprev = NULL;
+  np = posSearch[nodep].posSearchPoint;
+  nprev = 0;
   int suit = 0;
 
   /* If winning node has a card that equals the next winning card deduced
   from the position, then there already exists a (partial) path */
 
-  if (np == NULL)
+  if (np == 0)
   {
     /* There is no winning list created yet */
     /* Create winning nodes */
-    p2 = &(winCards[winSetSize]);
-    AddWinSet();
-    p2->next = NULL;
-    p2->nextWin = NULL;
-    p2->prevWin = NULL;
-    nodep->posSearchPoint = p2;
-    p2->winMask = winMask[suit];
-    p2->orderSet = winOrderSet[suit];
-    p2->first = NULL;
+    p2 = AddWinSet();
+    winCards[p2].next = 0;
+    winCards[p2].nextWin = 0;
+    winCards[p2].prevWin = 0;
+    posSearch[nodep].posSearchPoint = p2;
+    winCards[p2].winMask = winMask[suit];
+    winCards[p2].orderSet = winOrderSet[suit];
+    winCards[p2].first = 0;
     np = p2;           /* Latest winning node */
     suit++;
     while (suit < DDS_SUITS)
     {
-      p2 = &(winCards[winSetSize]);
-      AddWinSet();
-      np->nextWin = p2;
-      p2->prevWin = np;
-      p2->next = NULL;
-      p2->nextWin = NULL;
-      p2->winMask = winMask[suit];
-      p2->orderSet = winOrderSet[suit];
-      p2->first = NULL;
+      p2 = AddWinSet();
+      winCards[np].nextWin = p2;
+      winCards[p2].prevWin = np;
+      winCards[p2].next = 0;
+      winCards[p2].nextWin = 0;
+      winCards[p2].winMask = winMask[suit];
+      winCards[p2].orderSet = winOrderSet[suit];
+      winCards[p2].first = 0;
       np = p2;         /* Latest winning node */
       suit++;
     }
-    p = &(nodeCards[nodeSetSize]);
-    AddNodeSet();
-    np->first = p;
+    const unsigned p = AddNodeSet();
+    winCards[np].first = p;
     result = true;
-    return p;
+    return &nodeCards[p];
   }
   else
   {
@@ -690,16 +501,16 @@ nodeCardsType * TransTableS::BuildPath(
       found = false;
       while (1)      /* Find node amongst alternatives */
       {
-        if ((np->winMask == winMask[suit]) &&
-            (np->orderSet == winOrderSet[suit]))
+        if ((winCards[np].winMask == winMask[suit]) &&
+            (winCards[np].orderSet == winOrderSet[suit]))
         {
           /* Part of path found */
           found = true;
           nprev = np;
           break;
         }
-        if (np->next != NULL)
-          np = np->next;
+        if (winCards[np].next != 0)
+          np = winCards[np].next;
         else
           break;
       }
@@ -710,11 +521,11 @@ nodeCardsType * TransTableS::BuildPath(
         {
           result = false;
           return UpdateSOP(ubound, lbound, bestMoveSuit, bestMoveRank,
-            np->first);
+            &nodeCards[winCards[np].first]);
         }
         else
         {
-          np = np->nextWin;       /* Find next winning node  */
+          np = winCards[np].nextWin;       /* Find next winning node  */
           continue;
         }
       }
@@ -723,125 +534,95 @@ nodeCardsType * TransTableS::BuildPath(
     }               /* End outer while */
 
     /* Create additional node, coupled to existing node(s) */
-    p2 = &(winCards[winSetSize]);
-    AddWinSet();
-    p2->prevWin = nprev;
-    if (nprev != NULL)
+    p2 = AddWinSet();
+    winCards[p2].prevWin = nprev;
+    if (nprev != 0)
     {
-      p2->next = nprev->nextWin;
-      nprev->nextWin = p2;
+      winCards[p2].next = winCards[nprev].nextWin;
+      winCards[nprev].nextWin = p2;
     }
     else
     {
-      p2->next = nodep->posSearchPoint;
-      nodep->posSearchPoint = p2;
+      winCards[p2].next = posSearch[nodep].posSearchPoint;
+      posSearch[nodep].posSearchPoint = p2;
     }
-    p2->nextWin = NULL;
-    p2->winMask = winMask[suit];
-    p2->orderSet = winOrderSet[suit];
-    p2->first = NULL;
+    winCards[p2].nextWin = 0;
+    winCards[p2].winMask = winMask[suit];
+    winCards[p2].orderSet = winOrderSet[suit];
+    winCards[p2].first = 0;
     np = p2;          /* Latest winning node */
     suit++;
 
     /* Rest of path must be created */
     while (suit < 4)
     {
-      p2 = &(winCards[winSetSize]);
-      AddWinSet();
-      np->nextWin = p2;
-      p2->prevWin = np;
-      p2->next = NULL;
-      p2->winMask = winMask[suit];
-      p2->orderSet = winOrderSet[suit];
-      p2->first = NULL;
-      p2->nextWin = NULL;
+      p2 = AddWinSet();
+      winCards[np].nextWin = p2;
+      winCards[p2].prevWin = np;
+      winCards[p2].next = 0;
+      winCards[p2].winMask = winMask[suit];
+      winCards[p2].orderSet = winOrderSet[suit];
+      winCards[p2].first = 0;
+      winCards[p2].nextWin = 0;
       np = p2;         /* Latest winning node */
       suit++;
     }
 
     /* All winning nodes in SOP have been traversed and new nodes created */
-    p = &(nodeCards[nodeSetSize]);
-    AddNodeSet();
-    np->first = p;
+    const unsigned p = AddNodeSet();
+    winCards[np].first = p;
     result = true;
-    return p;
+    return &nodeCards[p];
   }
 }
 
-TransTableS::posSearchTypeSmall * TransTableS::SearchLenAndInsert(
-  posSearchTypeSmall * rootp,
+
+unsigned TransTableS::SearchLenAndInsert(
+  const unsigned rootp,
   const long long key,
   const bool insertNode,
   const int trick,
-  const int firstHand,
   bool& result)
 {
   /* Search for node which matches with the suit length combination
-  given by parameter key. If no such node is found, NULL is
+  given by parameter key. If no such node is found, 0 is
   returned if parameter insertNode is FALSE, otherwise a new
-  node is inserted with suitLengths set to key, the pointer to
+  node is inserted with suitLengths set to key, the index of
   this node is returned.
   The algorithm used is defined in Knuth "The art of computer
   programming", vol.3 "Sorting and searching", 6.2.2 Algorithm T,
   page 424. */
 
-  posSearchTypeSmall * np, *p, *sp;
-
-  sp = NULL;
-  if (insertNode)
-    sp = &(posSearch[trick][firstHand][lenSetInd[trick][firstHand]]);
-
-  np = rootp;
+  unsigned np = rootp;
   while (1)
   {
-    if (key == np->suitLengths)
+    posSearchTypeSmall * const nodep = &posSearch[np];
+    if (key == nodep->suitLengths)
     {
       result = true;
       return np;
     }
-    else if (key < np->suitLengths)
+
+    unsigned& child = (key < nodep->suitLengths ? 
+      nodep->left : nodep->right);
+
+    if (child != 0)
+      np = child;
+    else if (insertNode)
     {
-      if (np->left != NULL)
-        np = np->left;
-      else if (insertNode)
-      {
-        p = sp;
-        AddLenSet(trick, firstHand);
-        np->left = p;
-        p->posSearchPoint = NULL;
-        p->suitLengths = key;
-        p->left = NULL;
-        p->right = NULL;
-        result = true;
-        return p;
-      }
-      else
-      {
-        result = false;
-        return NULL;
-      }
+      const unsigned p = AddLenSet(trick);
+      child = p;
+      posSearch[p].posSearchPoint = 0;
+      posSearch[p].suitLengths = key;
+      posSearch[p].left = 0;
+      posSearch[p].right = 0;
+      result = true;
+      return p;
     }
-    else        /* key > suitLengths */
+    else
     {
-      if (np->right != NULL)
-        np = np->right;
-      else if (insertNode)
-      {
-        p = sp;
-        AddLenSet(trick, firstHand);
-        np->right = p;
-        p->posSearchPoint = NULL;
-        p->suitLengths = key;
-        p->left = NULL;
-        p->right = NULL;
-        result = true;
-        return p;
-      }
-      else
-      {
-        result = false;
-        return NULL;
-      }
+      result = false;
+      return 0;
     }
   }
 }
@@ -871,46 +652,46 @@ nodeCardsType * TransTableS::UpdateSOP(
 nodeCardsType const * TransTableS::FindSOP(
   const int orderSet[],
   const int limit,
-  winCardType * nodeP,
-  bool& lowerFlag)
+  const unsigned nodeP,
+  bool& lowerFlag) const
 {
-  winCardType * np;
-
-  np = nodeP;
+  unsigned np = nodeP;
   int s = 0;
 
   while (np)
   {
-    if ((np->winMask & orderSet[s]) == np->orderSet)
+    winCardType const * wp = &winCards[np];
+    if ((wp->winMask & orderSet[s]) == wp->orderSet)
     {
       /* Winning rank set fits position */
       if (s != 3)
       {
-        np = np->nextWin;
+        np = wp->nextWin;
         s++;
         continue;
       }
 
-      if (np->first->lbound > limit)
+      nodeCardsType const * cardsP = &nodeCards[wp->first];
+      if (cardsP->lbound > limit)
       {
         lowerFlag = true;
-        return np->first;
+        return cardsP;
       }
-      else if (np->first->ubound <= limit)
+      else if (cardsP->ubound <= limit)
       {
         lowerFlag = false;
-        return np->first;
+        return cardsP;
       }
     }
 
-    while (np->next == NULL)
+    while (winCards[np].next == 0)
     {
-      np = np->prevWin;
+      np = winCards[np].prevWin;
       s--;
-      if (np == NULL) /* Previous node is header node? */
+      if (np == 0) /* Previous node is header node? */
         return NULL;
     }
-    np = np->next;
+    np = winCards[np].next;
   }
   return NULL;
 }
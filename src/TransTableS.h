@@ -29,24 +29,24 @@ class TransTableS: public TransTable
 {
   private:
 
-    // Structures for the small memory option.
-
+    // Structures for the small memory option. The links are
+    // 32-bit indices into the arenas below, and 0 means none.
     struct winCardType
     {
       int orderSet;
       int winMask;
-      nodeCardsType * first;
-      winCardType * prevWin;
-      winCardType * nextWin;
-      winCardType * next;
+      unsigned first;
+      unsigned prevWin;
+      unsigned nextWin;
+      unsigned next;
     };
 
     struct posSearchTypeSmall
     {
-      winCardType * posSearchPoint;
       long long suitLengths;
-      posSearchTypeSmall * left;
-      posSearchTypeSmall * right;
+      unsigned posSearchPoint;
+      unsigned left;
+      unsigned right;
     };
 
     struct ttAggrType
@@ -65,32 +65,26 @@ class TransTableS: public TransTable
     long long aggrLenSets[14];
     statsResetsType statsResets;
 
-    winCardType temp_win[5];
-    int nodeSetSizeLimit;
-    int winSetSizeLimit;
     unsigned long long maxmem;
     unsigned long long allocmem;
-    unsigned long long summem;
-    int wmem;
-    int nmem;
-    int maxIndex;
-    int wcount;
-    int ncount;
+
     bool clearTTflag;
-    int windex;
+
     ttAggrType * aggp;
 
-    posSearchTypeSmall * rootnp[14][DDS_HANDS];
-    winCardType ** pw;
-    nodeCardsType ** pn;
-    posSearchTypeSmall ** pl[14][DDS_HANDS];
-    nodeCardsType * nodeCards;
+    // Bump arenas, allocated once in MakeTT. Entry 0 of each is
+    // unused so that an index of 0 can serve as a null link.
     winCardType * winCards;
-    posSearchTypeSmall * posSearch[14][DDS_HANDS];
-    int nodeSetSize; /* Index with range 0 to nodeSetSizeLimit */
-    int winSetSize;  /* Index with range 0 to winSetSizeLimit */
-    int lenSetInd[14][DDS_HANDS];
-    int lcount[14][DDS_HANDS];
+    nodeCardsType * nodeCards;
+    posSearchTypeSmall * posSearch;
+
+    unsigned winSetSize;  /* Usable entries in winCards */
+    unsigned nodeSetSize; /* Usable entries in nodeCards */
+    unsigned lenSetSize;  /* Usable entries in posSearch */
+
+    unsigned winSetNext;
+    unsigned nodeSetNext;
+    unsigned lenSetNext;
 
     vector<string> resetText;
 
@@ -100,17 +94,13 @@ class TransTableS: public TransTable
 
     void SetConstants();
 
-    void Wipe();
-
     void InitTT();
 
-    void AddWinSet();
+    unsigned AddWinSet();
 
-    void AddNodeSet();
+    unsigned AddNodeSet();
 
-    void AddLenSet(
-      const int trick, 
-      const int firstHand);
+    unsigned AddLenSet(const int trick);
 
     void BuildSOP(
       const unsigned short ourWinRanks[DDS_SUITS],
@@ -128,15 +118,14 @@ class TransTableS: public TransTable
       const int lbound,
       const char bestMoveSuit,
       const char bestMoveRank,
-      posSearchTypeSmall * node,
+      const unsigned node,
       bool& result);
 
-    struct posSearchTypeSmall * SearchLenAndInsert(
-      posSearchTypeSmall * rootp,
+    unsigned SearchLenAndInsert(
+      const unsigned rootp,
       const long long key,
       const bool insertNode,
       const int trick,
-      const int firstHand,
       bool& result);
 
     nodeCardsType * UpdateSOP(
@@ -149,8 +138,8 @@ class TransTableS: public TransTable
     nodeCardsType const * FindSOP(
       const int orderSet[],
       const int limit,
-      winCardType * nodeP,
-      bool& lowerFlag);
+      const unsigned nodeP,
+      bool& lowerFlag) const;
 
   public:
 
@@ -49,6 +49,7 @@ extern int rho[DDS_HANDS];
 extern int partner[DDS_HANDS];
 
 extern unsigned short int bitMapRank[16];
+extern unsigned long long bitMapCard[DDS_SUITS][16];
 
 extern unsigned char cardRank[16];
 extern unsigned char cardSuit[DDS_STRAINS];
@@ -102,6 +103,8 @@ struct pos
 {
   unsigned short int rankInSuit[DDS_HANDS][DDS_SUITS];
   unsigned short int aggr[DDS_SUITS];
+  /* The four words of a hand, and of aggr, are also used as one
+     64-bit bitboard; see FlipCard in ABsearch.cpp. */
   unsigned char length[DDS_HANDS][DDS_SUITS];
   int handDist[DDS_HANDS];
 
@@ -122,6 +125,21 @@ struct pos
 };
 
 
+// Strain policies for the search core. It is instantiated once
+// for notrump and once for suit contracts, so the tests for a trump
+// suit are resolved at compile time rather than at every node.
+
+struct StrainNT
+{
+  static const bool hasTrump = false;
+};
+
+struct StrainSuit
+{
+  static const bool hasTrump = true;
+};
+
+
 struct evalType
 {
   int tricks;
@@ -35,23 +35,30 @@ struct optEntry
   unsigned numArgs;
 };
 
-#define DTEST_NUM_OPTIONS 4
+#define DTEST_NUM_OPTIONS 5
 
 const std::array<optEntry, DTEST_NUM_OPTIONS> optList =
 {
   optEntry{"f", "file", 1},
   optEntry{"s", "solver", 1},
   optEntry{"n", "numthr", 1},
-  optEntry{"m", "memory", 1}
+  optEntry{"m", "memory", 1},
+  optEntry{"e", "endgame", 1}
 };
 
-const std::array<std::string, 5> solverList =
+const std::array<std::string, 11> solverList =
 {
   "solve",
   "calc",
   "play",
   "par",
-  "dealerpar"
+  "dealerpar",
+  "trace",
+  "session",
+  "speculate",
+  "line",
+  "batchpar",
+  "pbn"
 };
 
 std::string shortOptsAll, shortOptsWithArg;
@@ -80,7 +87,13 @@ void Usage(
     "                   (Default: input.txt)\n" <<
     "                   You can specify multiple to run cases in parallel.\n"
     "\n" <<
-    "-s, --solver       One of: solve, calc, play, par, dealerpar.\n" <<
+    "-s, --solver       One of: solve, calc, play, par, dealerpar,\n" <<
+    "                   trace (play, one trace at a time in parallel),\n" <<
+    "                   session (play, card by card in a game session),\n" <<
+    "                   speculate (session solving ahead),\n" <<
+    "                   line (optimal lines against solve),\n" <<
+    "                   batchpar (batch and grid par, against par),\n" <<
+    "                   pbn (batch PBN conversion and its faults).\n" <<
     "                   (Default: solve)\n" <<
     "                   You can specify multiple to run cases in parallel.\n"
     "\n" <<
@@ -90,6 +103,9 @@ void Usage(
     "-m, --memory n     Total DDS memory size in MB.\n" <<
     "                   (Default: 0 meaning that DDS decides)\n" <<
     "\n" <<
+    "-e, --endgame s    Endgame database made by egdbgen.\n" <<
+    "                   (Default: none)\n" <<
+    "\n" <<
     std::endl;
 }
 
@@ -148,6 +164,7 @@ void SetDefaults()
 {
   options.numThreads = 0;
   options.memoryMB = 0;
+  options.endgameDB = "";
 }
 
 
@@ -248,6 +265,10 @@ void ReadArgs(
         options.memoryMB = m;
         break;
 
+      case 'e':
+        options.endgameDB = optarg;
+        break;
+
       default:
         std::cout << "Unknown option\n";
         errFlag = true;
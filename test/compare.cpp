@@ -99,6 +99,31 @@ bool compare_DEALERPAR(
 }
 
 
+bool compare_MASTER(
+  const parResultsMaster& par1,
+  const parResultsMaster& par2)
+{
+  if (par1.score != par2.score)
+    return false;
+  if (par1.number != par2.number)
+    return false;
+
+  for (int i = 0; i < par1.number; i++)
+  {
+    const contractType& c1 = par1.contracts[i];
+    const contractType& c2 = par2.contracts[i];
+    if (c1.underTricks != c2.underTricks ||
+        c1.overTricks != c2.overTricks ||
+        c1.level != c2.level ||
+        c1.denom != c2.denom ||
+        c1.seats != c2.seats)
+      return false;
+  }
+
+  return true;
+}
+
+
 bool compare_TRACE(
   const solvedPlay& trace1,
   const solvedPlay& trace2)
@@ -33,6 +33,10 @@ bool compare_DEALERPAR(
   const parResultsDealer& par1,
   const parResultsDealer& par2);
 
+bool compare_MASTER(
+  const parResultsMaster& par1,
+  const parResultsMaster& par2);
+
 bool compare_TRACE(
   const solvedPlay& trace1,
   const solvedPlay& trace2);
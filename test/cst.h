@@ -21,7 +21,13 @@ enum Solver
   DTEST_SOLVER_PLAY = 2,
   DTEST_SOLVER_PAR = 3,
   DTEST_SOLVER_DEALERPAR = 4,
-  DTEST_SOLVER_SIZE = 5
+  DTEST_SOLVER_TRACE = 5,
+  DTEST_SOLVER_SESSION = 6,
+  DTEST_SOLVER_SPECULATE = 7,
+  DTEST_SOLVER_LINE = 8,
+  DTEST_SOLVER_BATCHPAR = 9,
+  DTEST_SOLVER_PBN = 10,
+  DTEST_SOLVER_SIZE = 11
 };
 
 struct OptionsType
@@ -30,6 +36,7 @@ struct OptionsType
   std::vector<Solver> solver;
   int numThreads;
   int memoryMB;
+  std::string endgameDB;
 };
 
 #endif
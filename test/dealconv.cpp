@@ -0,0 +1,181 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+// Converts a text file from hands/ to a deal file that SetDealFile()
+// maps. The deals are set up to be solved as in dtest, i.e. with
+// target -1, solutions 3 and mode 1.
+//
+// Usage: dealconv file.txt file.ddf
+
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "DealFile.h"
+#include "parse.h"
+#include "compare.h"
+
+// Solved again from the deal file as a check.
+#define DEALCONV_SOLVE 10
+
+
+int main(int argc, char * argv[])
+{
+  if (argc != 3)
+  {
+    std::cout << "Usage: " << argv[0] << " file.txt file.ddf\n";
+    return 1;
+  }
+
+  int number;
+  bool GIBmode = false;
+  int * dealer_list;
+  int * vul_list;
+  dealPBN * deal_list;
+  futureTricks * fut_list;
+  ddTableResults * table_list;
+  parResults * par_list;
+  parResultsDealer * dealerpar_list;
+  playTracePBN * play_list;
+  solvedPlay * trace_list;
+  if (! read_file(std::cout, argv[1], number, GIBmode, &dealer_list,
+      &vul_list, &deal_list, &fut_list, &table_list, &par_list,
+      &dealerpar_list, &play_list, &trace_list) || GIBmode)
+  {
+    std::cout << "Could not read " << argv[1] << "\n";
+    return 1;
+  }
+
+  const size_t number_t = static_cast<size_t>(number);
+  std::vector<deal> deals(number_t);
+  std::vector<dealFileInfoType> info(number_t);
+  std::vector<int> errors(number_t);
+
+  if (ConvertFromPBNAll(deal_list, number, deals.data(), errors.data()) !=
+      RETURN_NO_FAULT)
+  {
+    for (int i = 0; i < number; i++)
+      if (errors[i] != RETURN_NO_FAULT)
+        std::cout << "Deal " << i << ": error " << errors[i] << "\n";
+    return 1;
+  }
+
+  for (size_t i = 0; i < number_t; i++)
+  {
+    info[i].target = -1;
+    info[i].solutions = 3;
+    info[i].mode = 1;
+    info[i].dealer = dealer_list[i];
+    info[i].vulnerable = vul_list[i];
+  }
+
+  if (! DealFile::Write(argv[2], deals.data(), info.data(),
+      static_cast<unsigned long long>(number)))
+  {
+    std::cout << "Could not write " << argv[2] << "\n";
+    return 1;
+  }
+
+  // Read it back the way the solver will.
+  int numberRead;
+  if (SetDealFile(argv[2], &numberRead) != RETURN_NO_FAULT ||
+      numberRead != number)
+  {
+    std::cout << "Could not read back " << argv[2] << "\n";
+    return 1;
+  }
+
+  boards bo;
+  std::vector<int> dealers(MAXNOOFBOARDS), vuls(MAXNOOFBOARDS);
+  for (int i = 0; i < number; i += MAXNOOFBOARDS)
+  {
+    const int count = (i + MAXNOOFBOARDS > number ?
+      number - i : MAXNOOFBOARDS);
+    if (ReadDealFile(i, count, &bo, dealers.data(), vuls.data()) !=
+        RETURN_NO_FAULT)
+    {
+      std::cout << "Could not read deals from " << i << "\n";
+      return 1;
+    }
+
+    for (int j = 0; j < count; j++)
+    {
+      const deal& dl = deals[static_cast<size_t>(i + j)];
+      if (memcmp(bo.deals[j].remainCards, dl.remainCards,
+            sizeof(dl.remainCards)) != 0 ||
+          bo.deals[j].trump != dl.trump ||
+          bo.deals[j].first != dl.first ||
+          dealers[static_cast<size_t>(j)] != dealer_list[i + j] ||
+          vuls[static_cast<size_t>(j)] != vul_list[i + j])
+      {
+        std::cout << "Deal " << i + j << " differs\n";
+        return 1;
+      }
+    }
+  }
+
+  solvedBoards solved;
+  const int numSolve = (number < DEALCONV_SOLVE ? number : DEALCONV_SOLVE);
+  if (SolveDealFile(0, numSolve, &solved) != RETURN_NO_FAULT)
+  {
+    std::cout << "Could not solve from " << argv[2] << "\n";
+    return 1;
+  }
+
+  for (int i = 0; i < numSolve; i++)
+  {
+    if (! compare_FUT(solved.solvedBoard[i], fut_list[i]))
+    {
+      std::cout << "Deal " << i << " solves differently\n";
+      return 1;
+    }
+  }
+
+  // A copy with a trump of 7 in the last record must be refused.
+  std::ifstream fin(argv[2], std::ios::binary);
+  std::vector<char> bytes((std::istreambuf_iterator<char>(fin)),
+    std::istreambuf_iterator<char>());
+  fin.close();
+  char& trumpByte = bytes[bytes.size() - DEAL_FILE_RECORD + 13];
+  trumpByte = static_cast<char>(trumpByte | 7);
+
+  const std::string badName = std::string(argv[2]) + ".bad";
+  std::ofstream fout(badName, std::ios::binary);
+  fout.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  fout.close();
+
+  const int badRes = SetDealFile(badName.c_str(), &numberRead);
+  const int badRead = ReadDealFile(number - 1, 1, &bo, nullptr, nullptr);
+  SetDealFile(nullptr, nullptr);
+  remove(badName.c_str());
+  if (badRes != RETURN_NO_FAULT || badRead != RETURN_DEAL_FILE)
+  {
+    std::cout << "Bad record in " << badName << " was not refused\n";
+    return 1;
+  }
+
+  free(dealer_list);
+  free(vul_list);
+  free(deal_list);
+  free(fut_list);
+  free(table_list);
+  free(par_list);
+  free(dealerpar_list);
+  free(play_list);
+  free(trace_list);
+
+  std::cout << "Wrote " << number << " deals to " << argv[2] << "\n";
+  return 0;
+}
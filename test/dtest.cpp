@@ -10,6 +10,7 @@
 
 #include <future>
 #include <iostream>
+#include <iomanip>
 
 #include "dll.h"
 #include "testcommon.h"
@@ -25,6 +26,18 @@ int main(int argc, char * argv[])
 
   SetResources(options.memoryMB, options.numThreads);
 
+  if (! options.endgameDB.empty())
+  {
+    int res = SetEndgameDatabase(options.endgameDB.c_str());
+    if (res != RETURN_NO_FAULT)
+    {
+      char line[80];
+      ErrorMessage(res, line);
+      std::cout << options.endgameDB << ": " << line << std::endl;
+      return 1;
+    }
+  }
+
   DDSInfo info;
   GetDDSInfo(&info);
   std::cout << info.systemString << std::endl;
@@ -44,5 +57,19 @@ int main(int argc, char * argv[])
   int r = 0;
   for (std::future<int>& f: rv)
     r |= f.get();
+
+  DDSStats stats;
+  GetDDSStats(&stats);
+  std::cout << std::setw(21) << std::left << "TT lookups" <<
+    std::setw(12) << std::right << stats.ttLookups << "\n";
+  std::cout << std::setw(21) << std::left << "TT hit rate" <<
+    std::setw(12) << std::right << std::fixed << std::setprecision(4) <<
+    (stats.ttLookups == 0 ? 0. :
+      stats.ttHits / static_cast<double>(stats.ttLookups)) << "\n";
+  std::cout << std::setw(21) << std::left << "AB nodes" <<
+    std::setw(12) << std::right << stats.abNodes << "\n";
+  std::cout << std::setw(21) << std::left << "AB root searches" <<
+    std::setw(12) << std::right << stats.abRootSearches << std::endl;
+
   return r;
 }
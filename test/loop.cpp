@@ -8,8 +8,13 @@
 */
 
 
+#include <chrono>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 #include <string.h>
 
 #include "loop.h"
@@ -21,6 +26,45 @@
 
 extern thread_local TestTimer timer;
 
+int trick_winner(
+  const int suits[],
+  const int ranks[],
+  const int leader,
+  const int trump);
+
+int session_trace(
+  const dealPBN& dl,
+  const playTracePBN& play,
+  const bool pause,
+  solvedPlay& solved);
+
+void play_card(
+  deal& dl,
+  const int suit,
+  const int rank);
+
+bool same_cards(
+  const futureTricks& fut1,
+  const futureTricks& fut2);
+
+int check_line(
+  const deal& dl,
+  const optimalLine& line);
+
+std::string dealer_text(
+  const parResultsDealer& par);
+
+bool sides_text(
+  const parTextResults& text,
+  const parResults& par);
+
+bool check_single_sacrifice(std::ostream &out);
+
+bool check_grid(std::ostream &out,
+  ddTableResults& table);
+
+bool check_pbn_faults(std::ostream &out);
+
 
 void loop_solve(std::ostream &out,
   boardsPBN * bop,
@@ -301,3 +345,725 @@ bool loop_play(std::ostream &out,
   return true;
 }
 
+
+bool loop_trace(std::ostream &out,
+  dealPBN * deal_list,
+  playTracePBN * play_list,
+  solvedPlay * trace_list,
+  const int number,
+  const int stepsize)
+{
+  // Each trace on its own, with the positions solved in parallel.
+  solvedPlay solved;
+
+#ifdef BATCHTIMES
+  out << std::setw(8) << std::left << "Hand no." <<
+    std::setw(25) << std::right << "Time" << "\n";
+#endif
+
+  for (int i = 0; i < number; i += stepsize)
+  {
+    int count = (i + stepsize > number ? number - i : stepsize);
+
+    timer.start(count);
+    for (int j = 0; j < count; j++)
+    {
+      int ret;
+      if ((ret = AnalysePlayPBNParallel(deal_list[i+j], play_list[i+j],
+          &solved)) != RETURN_NO_FAULT)
+      {
+        printf("loop_trace i %i, j %i: Return %d\n", i, j, ret);
+        out << "loop_trace: i " << i << ", j " << j << ": " <<
+          "return " << ret << "\n";
+        exit(EXIT_FAILURE);
+      }
+
+      if (compare_TRACE(solved, trace_list[i+j]))
+        continue;
+
+      printf("loop_trace i %d, j %d: Difference\n", i, j);
+      out << "loop_trace: i " << i << ", j " << j << ": " <<
+        "Difference\n\n";
+      print_double_TRACE(out, solved, trace_list[i+j]);
+      out << "\n";
+      exit(EXIT_FAILURE);
+    }
+    timer.end();
+
+#ifdef BATCHTIMES
+    timer.printRunning(out, i+count, number);
+#endif
+  }
+
+#ifdef BATCHTIMES
+  printf("\n");
+#endif
+
+  return true;
+}
+
+
+int trick_winner(
+  const int suits[],
+  const int ranks[],
+  const int leader,
+  const int trump)
+{
+  int best = 0;
+  for (int k = 1; k < 4; k++)
+  {
+    if (suits[k] == suits[best])
+    {
+      if (ranks[k] > ranks[best])
+        best = k;
+    }
+    else if (suits[k] == trump)
+      best = k;
+  }
+  return (leader + best) % 4;
+}
+
+
+int session_trace(
+  const dealPBN& dl,
+  const playTracePBN& play,
+  const bool pause,
+  solvedPlay& solved)
+{
+  // Plays the trace through a game session on thread 0. As in
+  // AnalysePlayPBN, the scores become the tricks of the side that
+  // was not on lead at the start, and the last trick is not played.
+  // With pause, each card waits a little, as a client would, so
+  // that some cards are solved ahead.
+  const char suitChars[] = "SHDC";
+  const char rankChars[] = "23456789TJQKA";
+
+  int handCards = 0;
+  for (const char * p = dl.remainCards + 2; * p; p++)
+    if (strchr(rankChars, * p))
+      handCards++;
+
+  int suits[4], ranks[4];
+  int trickCards = 0;
+  while (trickCards < 3 && dl.currentTrickRank[trickCards] != 0)
+  {
+    suits[trickCards] = dl.currentTrickSuit[trickCards];
+    ranks[trickCards] = dl.currentTrickRank[trickCards];
+    trickCards++;
+  }
+
+  int tricksLeft = (handCards + trickCards + 3) / 4;
+  const int played = (play.number < 4 * (tricksLeft - 1) ?
+    play.number : 4 * (tricksLeft - 1));
+  const int numPlay = played - trickCards;
+
+  int leader = dl.first;
+  const int startSide = dl.first % 2;
+  int declarer = 0;
+
+  futureTricks fut;
+  int ret = StartSessionPBN(dl, 0, &fut);
+  if (ret != RETURN_NO_FAULT)
+    return ret;
+
+  solved.number = numPlay + 1;
+  solved.tricks[0] = ((leader + trickCards) % 2 == startSide ?
+    tricksLeft - fut.score[0] : fut.score[0]);
+
+  for (int c = 0; c < numPlay; c++)
+  {
+    const int suit = static_cast<int>(
+      strchr(suitChars, play.cards[2*c]) - suitChars);
+    const int rank = static_cast<int>(
+      strchr(rankChars, play.cards[2*c + 1]) - rankChars) + 2;
+
+    suits[trickCards] = suit;
+    ranks[trickCards] = rank;
+    if (trickCards == 3)
+    {
+      leader = trick_winner(suits, ranks, leader, dl.trump);
+      declarer += (leader % 2 == startSide ? 0 : 1);
+      tricksLeft--;
+      trickCards = 0;
+    }
+    else
+      trickCards++;
+
+    if (pause)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    if ((ret = SessionPlayCard(suit, rank, 0, &fut)) != RETURN_NO_FAULT)
+      return ret;
+
+    solved.tricks[c+1] = declarer +
+      ((leader + trickCards) % 2 == startSide ?
+        tricksLeft - fut.score[0] : fut.score[0]);
+  }
+
+  return RETURN_NO_FAULT;
+}
+
+
+bool loop_session(std::ostream &out,
+  dealPBN * deal_list,
+  playTracePBN * play_list,
+  solvedPlay * trace_list,
+  const int number,
+  const int stepsize,
+  const int speculation)
+{
+  solvedPlay solved;
+  SetSessionSpeculation(speculation, 0);
+
+#ifdef BATCHTIMES
+  out << std::setw(8) << std::left << "Hand no." <<
+    std::setw(25) << std::right << "Time" << "\n";
+#endif
+
+  for (int i = 0; i < number; i += stepsize)
+  {
+    int count = (i + stepsize > number ? number - i : stepsize);
+
+    timer.start(count);
+    for (int j = 0; j < count; j++)
+    {
+      int ret;
+      if ((ret = session_trace(deal_list[i+j], play_list[i+j],
+          speculation > 0, solved)) != RETURN_NO_FAULT)
+      {
+        printf("loop_session i %i, j %i: Return %d\n", i, j, ret);
+        out << "loop_session: i " << i << ", j " << j << ": " <<
+          "return " << ret << "\n";
+        exit(EXIT_FAILURE);
+      }
+
+      if (compare_TRACE(solved, trace_list[i+j]))
+        continue;
+
+      printf("loop_session i %d, j %d: Difference\n", i, j);
+      out << "loop_session: i " << i << ", j " << j << ": " <<
+        "Difference\n\n";
+      print_double_TRACE(out, solved, trace_list[i+j]);
+      out << "\n";
+      exit(EXIT_FAILURE);
+    }
+    timer.end();
+
+#ifdef BATCHTIMES
+    timer.printRunning(out, i+count, number);
+#endif
+  }
+
+  SetSessionSpeculation(0, 0);
+
+#ifdef BATCHTIMES
+  printf("\n");
+#endif
+
+  return true;
+}
+
+
+void play_card(
+  deal& dl,
+  const int suit,
+  const int rank)
+{
+  int trickCards = 0;
+  while (trickCards < 3 && dl.currentTrickRank[trickCards] != 0)
+    trickCards++;
+
+  const int player = (dl.first + trickCards) % 4;
+  dl.remainCards[player][suit] &= ~(1u << rank);
+
+  if (trickCards < 3)
+  {
+    dl.currentTrickSuit[trickCards] = suit;
+    dl.currentTrickRank[trickCards] = rank;
+    return;
+  }
+
+  int suits[4], ranks[4];
+  for (int k = 0; k < 3; k++)
+  {
+    suits[k] = dl.currentTrickSuit[k];
+    ranks[k] = dl.currentTrickRank[k];
+    dl.currentTrickSuit[k] = 0;
+    dl.currentTrickRank[k] = 0;
+  }
+  suits[3] = suit;
+  ranks[3] = rank;
+  dl.first = trick_winner(suits, ranks, dl.first, dl.trump);
+}
+
+
+bool same_cards(
+  const futureTricks& fut1,
+  const futureTricks& fut2)
+{
+  // The same cards with the same scores, in any order.
+  unsigned cards1[DDS_SUITS] = {0, 0, 0, 0};
+  unsigned cards2[DDS_SUITS] = {0, 0, 0, 0};
+
+  for (int i = 0; i < fut1.cards; i++)
+  {
+    if (fut1.score[i] != fut1.score[0])
+      return false;
+    cards1[fut1.suit[i]] |= (1u << fut1.rank[i]) |
+      static_cast<unsigned>(fut1.equals[i]);
+  }
+
+  for (int i = 0; i < fut2.cards; i++)
+  {
+    if (fut2.score[i] != fut2.score[0])
+      return false;
+    cards2[fut2.suit[i]] |= (1u << fut2.rank[i]) |
+      static_cast<unsigned>(fut2.equals[i]);
+  }
+
+  if (fut1.cards > 0 && fut2.cards > 0 && fut1.score[0] != fut2.score[0])
+    return false;
+
+  return (memcmp(cards1, cards2, sizeof(cards1)) == 0);
+}
+
+
+int check_line(
+  const deal& dl,
+  const optimalLine& line)
+{
+  // Each position of the line has to solve the same with SolveBoard.
+  // Returns the first position that does not, or -1.
+  deal pos = dl;
+  futureTricks fut;
+
+  for (int n = 0; n < line.number; n++)
+  {
+    const futureTricks& lfut = line.fut[n];
+    if (SolveBoard(pos, -1, 2, 1, &fut, 0) != RETURN_NO_FAULT ||
+        ! same_cards(lfut, fut))
+      return n;
+
+    play_card(pos, lfut.suit[0], lfut.rank[0]);
+  }
+
+  return -1;
+}
+
+
+bool loop_line(std::ostream &out,
+  dealPBN * deal_list,
+  const int number,
+  const int stepsize)
+{
+  deal dl;
+  optimalLine line;
+
+#ifdef BATCHTIMES
+  out << std::setw(8) << std::left << "Hand no." <<
+    std::setw(25) << std::right << "Time" << "\n";
+#endif
+
+  for (int i = 0; i < number; i += stepsize)
+  {
+    int count = (i + stepsize > number ? number - i : stepsize);
+
+    timer.start(count);
+    for (int j = 0; j < count; j++)
+    {
+      int ret;
+      if ((ret = ConvertFromPBNAll(&deal_list[i+j], 1, &dl, nullptr))
+          != RETURN_NO_FAULT ||
+          (ret = GetOptimalLine(dl, 0, &line)) != RETURN_NO_FAULT)
+      {
+        printf("loop_line i %i, j %i: Return %d\n", i, j, ret);
+        out << "loop_line: i " << i << ", j " << j << ": " <<
+          "return " << ret << "\n";
+        exit(EXIT_FAILURE);
+      }
+
+      const int n = check_line(dl, line);
+      if (n == -1)
+        continue;
+
+      printf("loop_line i %d, j %d: Difference in position %d\n",
+        i, j, n);
+      out << "loop_line: i " << i << ", j " << j << ": " <<
+        "Difference in position " << n << "\n";
+      exit(EXIT_FAILURE);
+    }
+    timer.end();
+
+#ifdef BATCHTIMES
+    timer.printRunning(out, i+count, number);
+#endif
+  }
+
+#ifdef BATCHTIMES
+  printf("\n");
+#endif
+
+  return true;
+}
+
+
+std::string dealer_text(
+  const parResultsDealer& par)
+{
+  // The DealerPar() reference as ConvertToDealerTextFormat() writes
+  // it. "4S*-EW-1" becomes "EW 4Sx-1", the single sacrificer
+  // "5C-E-2" becomes "E 5Cx-2" and "3N-NS+1" becomes "NS 3N+1". The
+  // binary contracts are in the order NT, S, H, D, C.
+  const std::string denoms = "NSHDC";
+  std::vector<std::string> contracts[5];
+
+  for (int n = 0; n < par.number; n++)
+  {
+    const std::string c = par.contracts[n];
+    const size_t start = (c[2] == '*' ? 4 : 3);
+    const size_t end = c.find_first_of("+-", start);
+    const std::string seats = c.substr(start, end - start);
+    const std::string delta = (end == std::string::npos ? "" : c.substr(end));
+
+    contracts[denoms.find(c[1])].push_back(seats + " " + c.substr(0, 2) +
+      (delta[0] == '-' ? "x" : "") + delta);
+  }
+
+  std::string text = "Par " + std::to_string(par.score) + ": ";
+  bool first = true;
+  for (auto& list: contracts)
+  {
+    for (auto& contract: list)
+    {
+      text += (first ? "" : " ") + contract;
+      first = false;
+    }
+  }
+  return text;
+}
+
+
+bool sides_text(
+  const parTextResults& text,
+  const parResults& par)
+{
+  // The ConvertToSidesTextFormat() text "Par -110: EW 2S EW 2D+1" is
+  // "NS -110" and "NS:EW 2S,EW 23D" in the reference from Par(),
+  // which lists the levels that make and leaves out the undertricks.
+  if (strcmp(text.parText[0], "Par 0") == 0)
+    return (strcmp(par.parScore[0], "NS 0") == 0);
+
+  for (int i = 0; i < 2; i++)
+  {
+    const std::string side = (i == 0 ? "NS" : "EW");
+    std::istringstream iss(text.parText[i]);
+    std::string word, seats, contract;
+    int score;
+    iss >> word >> score >> word;
+
+    if (side + " " + std::to_string(score) != par.parScore[i])
+      return false;
+
+    std::string list = side + ":";
+    bool first = true;
+    while (iss >> seats >> contract)
+    {
+      const int level = contract[0] - '0';
+      const size_t end = (contract[1] == 'N' ? 3 : 2);
+      const std::string delta = contract.substr(end);
+
+      std::string levels = std::to_string(level);
+      if (delta[0] == '+')
+        for (int l = 1; l <= std::stoi(delta.substr(1)); l++)
+          levels += std::to_string(level + l);
+
+      list += (first ? "" : ",") + seats + " " + levels + contract[1] +
+        (delta[0] == 'x' ? "x" : "");
+      first = false;
+    }
+
+    if (list != par.parContractsString[i])
+      return false;
+  }
+
+  return true;
+}
+
+
+bool check_single_sacrifice(std::ostream &out)
+{
+  // North-South make 5C, vulnerable. East deals and is the only one
+  // who saves in clubs two down, "5C-E-2". DealerParBin() used to
+  // give this single sacrificer 0 or -48 undertricks.
+  ddTableResults table = {{ {5, 7, 5, 7}, {5, 7, 5, 7}, {6, 6, 6, 6},
+    {11, 9, 10, 8}, {6, 6, 6, 6} }};
+  int dealer = 1, vul = 2;
+
+  parResultsDealer par;
+  parResultsMaster bin, batch;
+  char text[128];
+  if (DealerPar(&table, &par, dealer, vul) != RETURN_NO_FAULT ||
+      DealerParBin(&table, &bin, dealer, vul) != RETURN_NO_FAULT ||
+      DealerParBinAll(&table, &dealer, &vul, 1, &batch) != RETURN_NO_FAULT ||
+      ConvertToDealerTextFormat(&batch, text) != RETURN_NO_FAULT)
+  {
+    out << "check_single_sacrifice: return fault\n";
+    return false;
+  }
+
+  const contractType& c = bin.contracts[0];
+  if (par.number != 1 || strcmp(par.contracts[0], "5C-E-2") ||
+      bin.score != 300 || bin.number != 1 ||
+      c.underTricks != 2 || c.overTricks != 0 ||
+      c.level != 5 || c.denom != 4 || c.seats != 1 ||
+      ! compare_MASTER(bin, batch) ||
+      strcmp(text, "Par 300: E 5Cx-2") ||
+      dealer_text(par) != text)
+  {
+    out << "check_single_sacrifice: " << par.contracts[0] << ", " <<
+      text << ", undertricks " << c.underTricks << "\n";
+    return false;
+  }
+
+  return true;
+}
+
+
+bool check_grid(std::ostream &out,
+  ddTableResults& table)
+{
+  // Each cell of DealerParBinGrid() against DealerParBin().
+  parResultsGrid grid = { };
+  int ret;
+  if ((ret = DealerParBinGrid(&table, &grid)) != RETURN_NO_FAULT)
+  {
+    out << "check_grid: return " << ret << "\n";
+    return false;
+  }
+
+  for (int vul = 0; vul < 4; vul++)
+  {
+    for (int dealer = 0; dealer < DDS_HANDS; dealer++)
+    {
+      parResultsMaster cell = { };
+      if ((ret = DealerParBin(&table, &cell, dealer, vul))
+          != RETURN_NO_FAULT)
+      {
+        out << "check_grid: return " << ret << "\n";
+        return false;
+      }
+
+      if (compare_MASTER(grid.results[vul][dealer], cell))
+        continue;
+
+      out << "check_grid: vul " << vul << ", dealer " << dealer <<
+        ": Difference\n";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+bool loop_batchpar(std::ostream &out,
+  int * dealer_list,
+  int * vul_list,
+  ddTableResults * table_list,
+  parResults * par_list,
+  parResultsDealer * dealerpar_list,
+  const int number)
+{
+  // The batch functions against SidesParBin() and DealerParBin() for
+  // each table, and their text against the Par() and DealerPar()
+  // reference. Also DealerParBinGrid() against DealerParBin().
+  if (! check_single_sacrifice(out))
+    exit(EXIT_FAILURE);
+
+  std::vector<parResultsMaster> sides(2 * static_cast<unsigned>(number));
+  std::vector<parResultsMaster> dealers(static_cast<unsigned>(number));
+
+  timer.start(number);
+  int ret;
+  if ((ret = SidesParBinAll(table_list, vul_list, number, sides.data()))
+      != RETURN_NO_FAULT ||
+      (ret = DealerParBinAll(table_list, dealer_list, vul_list, number,
+        dealers.data())) != RETURN_NO_FAULT)
+  {
+    out << "loop_batchpar: return " << ret << "\n";
+    exit(EXIT_FAILURE);
+  }
+  timer.end();
+
+  for (int i = 0; i < number; i++)
+  {
+    parResultsMaster sidesRef[2] = { }, dealerRef = { };
+    parTextResults sidesText;
+    char dealerText[128];
+    const unsigned u = static_cast<unsigned>(i);
+
+    if ((ret = SidesParBin(&table_list[i], sidesRef, vul_list[i]))
+        != RETURN_NO_FAULT ||
+        (ret = DealerParBin(&table_list[i], &dealerRef, dealer_list[i],
+          vul_list[i])) != RETURN_NO_FAULT ||
+        (ret = ConvertToSidesTextFormat(&sides[2 * u], &sidesText))
+          != RETURN_NO_FAULT ||
+        (ret = ConvertToDealerTextFormat(&dealers[u], dealerText))
+          != RETURN_NO_FAULT)
+    {
+      out << "loop_batchpar: i " << i << ": return " << ret << "\n";
+      exit(EXIT_FAILURE);
+    }
+
+    if (! compare_MASTER(sides[2 * u], sidesRef[0]) ||
+        ! compare_MASTER(sides[2 * u + 1], sidesRef[1]) ||
+        ! compare_MASTER(dealers[u], dealerRef))
+    {
+      out << "loop_batchpar i " << i << ": Difference to one table\n";
+      exit(EXIT_FAILURE);
+    }
+
+    if (! sides_text(sidesText, par_list[i]))
+    {
+      out << "loop_batchpar i " << i << ": Sides text difference\n\n" <<
+        sidesText.parText[0] << "\n" << sidesText.parText[1] << "\n";
+      out << "\nExpected outcome was:\n";
+      print_PAR(out, par_list[i]);
+      exit(EXIT_FAILURE);
+    }
+
+    if (! check_grid(out, table_list[i]))
+    {
+      out << "loop_batchpar i " << i << ": Grid difference\n";
+      exit(EXIT_FAILURE);
+    }
+
+    if (dealer_text(dealerpar_list[i]) != dealerText)
+    {
+      out << "loop_batchpar i " << i << ": Dealer text difference\n\n" <<
+        dealerText << "\n";
+      out << "\nExpected outcome was:\n";
+      print_DEALERPAR(out, dealerpar_list[i]);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+#ifdef BATCHTIMES
+  timer.printRunning(out, number, number);
+#endif
+
+  return true;
+}
+
+
+bool check_pbn_faults(std::ostream &out)
+{
+  // One deal for each kind of fault, and the code that the batch
+  // conversions give for it.
+  const char * cases[] =
+  {
+    "N:QJ6.K652.J85.T98 873.J97.AT764.Q4 K5.T83.KQ9.A7652 AT942.AQ4.32.KJ3",
+    "N QJ6.K652.J85.T98 873.J97.AT764.Q4 K5.T83.KQ9.A7652 AT942.AQ4.32.KJ3",
+    "N:QJ6.K652.J85.T9.8 873.J97.AT764.Q4 K5.T83.KQ9.A7652 AT942.AQ4.32.KJ3",
+    "N:QJ6.K652.J85.T98 873.J97.AT764.Q4 K5.T83.KQ9.A7652 AT942.AQ4.32.KJ 3",
+    "N:QJ6.K652.J85.T98 873.J97.AT7#64.Q4 K5.T83.KQ9.A7652 AT942.AQ4.32.KJ3",
+    "N:QJ6.K652.J85.T983 873.J97.AT764.Q4 K5.T83.KQ9.A7652 AT942.AQ4.32.KJ",
+    "N:QJ6.K652.J85.T98 873.J97.AT764.Q4 K5.T83.KQ9.A7652 AT942.AQ4.32.KJ8"
+  };
+  const char * kinds[] =
+  {
+    "valid", "no colon", "fifth suit", "fifth hand", "stray character",
+    "14 cards", "duplicate card"
+  };
+  const int expected[] =
+  {
+    RETURN_NO_FAULT, RETURN_PBN_FAULT, RETURN_PBN_FAULT, RETURN_PBN_FAULT,
+    RETURN_PBN_FAULT, RETURN_TOO_MANY_CARDS, RETURN_DUPLICATE_CARDS
+  };
+  const int number = sizeof(expected) / sizeof(expected[0]);
+
+  dealPBN dealsPBN[number];
+  ddTableDealPBN tablesPBN[number];
+  deal deals[number];
+  ddTableDeal tables[number];
+  int resDeals[number], resTables[number];
+
+  for (int i = 0; i < number; i++)
+  {
+    dealsPBN[i] = dealPBN{ 0, 0, {0, 0, 0}, {0, 0, 0}, "" };
+    strcpy(dealsPBN[i].remainCards, cases[i]);
+    strcpy(tablesPBN[i].cards, cases[i]);
+  }
+
+  if (ConvertFromPBNAll(dealsPBN, number, deals, resDeals)
+      != RETURN_PBN_FAULT ||
+      ConvertTablesFromPBNAll(tablesPBN, number, tables, resTables)
+      != RETURN_PBN_FAULT)
+  {
+    out << "check_pbn_faults: no fault returned\n";
+    return false;
+  }
+
+  for (int i = 0; i < number; i++)
+  {
+    if (resDeals[i] == expected[i] && resTables[i] == expected[i])
+      continue;
+
+    out << "check_pbn_faults: " << kinds[i] << " gives " <<
+      resDeals[i] << " and " << resTables[i] << ", not " <<
+      expected[i] << "\n";
+    return false;
+  }
+
+  return true;
+}
+
+
+bool loop_pbn(std::ostream &out,
+  dealPBN * deal_list,
+  const int number)
+{
+  // The fixed faults, and then the whole file in one batch, where
+  // the deals and the tables have to convert to the same cards.
+  if (! check_pbn_faults(out))
+    exit(EXIT_FAILURE);
+
+  const unsigned n = static_cast<unsigned>(number);
+  std::vector<ddTableDealPBN> tablesPBN(n);
+  std::vector<deal> deals(n);
+  std::vector<ddTableDeal> tables(n);
+  std::vector<int> resDeals(n), resTables(n);
+
+  for (unsigned i = 0; i < n; i++)
+    strcpy(tablesPBN[i].cards, deal_list[i].remainCards);
+
+  timer.start(number);
+  int ret;
+  if ((ret = ConvertFromPBNAll(deal_list, number, deals.data(),
+        resDeals.data())) != RETURN_NO_FAULT ||
+      (ret = ConvertTablesFromPBNAll(tablesPBN.data(), number,
+        tables.data(), resTables.data())) != RETURN_NO_FAULT)
+  {
+    out << "loop_pbn: return " << ret << "\n";
+    exit(EXIT_FAILURE);
+  }
+  timer.end();
+
+  for (unsigned i = 0; i < n; i++)
+  {
+    if (resDeals[i] == RETURN_NO_FAULT &&
+        resTables[i] == RETURN_NO_FAULT &&
+        memcmp(deals[i].remainCards, tables[i].cards,
+          sizeof(tables[i].cards)) == 0)
+      continue;
+
+    out << "loop_pbn i " << i << ": Difference\n";
+    exit(EXIT_FAILURE);
+  }
+
+#ifdef BATCHTIMES
+  timer.printRunning(out, number, number);
+#endif
+
+  return true;
+}
@@ -45,6 +45,18 @@ bool loop_dealerpar(std::ostream &out,
   const int number,
   const int stepsize);
 
+bool loop_batchpar(std::ostream &out,
+  int * dealer_list,
+  int * vul_list,
+  ddTableResults * table_list,
+  parResults * par_list,
+  parResultsDealer * dealerpar_list,
+  const int number);
+
+bool loop_pbn(std::ostream &out,
+  dealPBN * deal_list,
+  const int number);
+
 bool loop_play(std::ostream &out,
   boardsPBN * bop,
   playTracesPBN * playsp,
@@ -55,5 +67,25 @@ bool loop_play(std::ostream &out,
   const int number,
   const int stepsize);
 
+bool loop_session(std::ostream &out,
+  dealPBN * deal_list,
+  playTracePBN * play_list,
+  solvedPlay * trace_list,
+  const int number,
+  const int stepsize,
+  const int speculation);
+
+bool loop_line(std::ostream &out,
+  dealPBN * deal_list,
+  const int number,
+  const int stepsize);
+
+bool loop_trace(std::ostream &out,
+  dealPBN * deal_list,
+  playTracePBN * play_list,
+  solvedPlay * trace_list,
+  const int number,
+  const int stepsize);
+
 #endif
 
@@ -0,0 +1,412 @@
+/*
+   DDS, a bridge double dummy solver.
+
+   Copyright (C) 2006-2014 by Bo Haglund /
+   2014-2018 by Bo Haglund & Soren Hein.
+
+   See LICENSE and README.
+*/
+
+/*
+   Microbenchmark for SortMoves. It checks that the key sort leaves
+   the moves in exactly the order of the original sorting networks,
+   which are kept below as the reference, and it times both.
+
+   sortbench [number of sorts]
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+
+#include "MoveSort.h"
+
+using namespace std;
+
+using Clock = std::chrono::steady_clock;
+
+
+void ReferenceSort(
+  moveType mply[],
+  const int numMoves);
+
+void MakeInputs(
+  vector<moveType>& moves,
+  vector<int>& lengths,
+  const int number);
+
+bool SameOrder(
+  const moveType * mp1,
+  const moveType * mp2,
+  const int len);
+
+double TimeSort(
+  void (* sortFnc)(moveType [], const int),
+  const vector<moveType>& moves,
+  const vector<int>& lengths);
+
+
+#define CMP_SWAP(i, j) if (mply[i].weight < mply[j].weight) \
+  { tmp = mply[i]; mply[i] = mply[j]; mply[j] = tmp; }
+
+void ReferenceSort(
+  moveType mply[],
+  const int numMoves)
+{
+  moveType tmp;
+
+  switch (numMoves)
+  {
+    case 12:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(8, 9);
+      CMP_SWAP(10, 11);
+
+      CMP_SWAP(1, 3);
+      CMP_SWAP(5, 7);
+      CMP_SWAP(9, 11);
+
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(8, 10);
+
+      CMP_SWAP(1, 2);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(9, 10);
+
+      CMP_SWAP(1, 5);
+      CMP_SWAP(6, 10);
+      CMP_SWAP(5, 9);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(6, 10);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(7, 11);
+      CMP_SWAP(3, 7);
+      CMP_SWAP(4, 8);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(7, 11);
+      CMP_SWAP(1, 4);
+      CMP_SWAP(7, 10);
+      CMP_SWAP(3, 8);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(8, 9);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(7, 9);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(6, 8);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(7, 8);
+      break;
+    case 11:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(8, 9);
+
+      CMP_SWAP(1, 3);
+      CMP_SWAP(5, 7);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(8, 10);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(9, 10);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(6, 10);
+      CMP_SWAP(5, 9);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(6, 10);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(3, 7);
+      CMP_SWAP(4, 8);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(1, 4);
+      CMP_SWAP(7, 10);
+      CMP_SWAP(3, 8);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(8, 9);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(7, 9);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(6, 8);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(7, 8);
+      break;
+    case 10:
+      CMP_SWAP(1, 8);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(5, 9);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(3, 7);
+      CMP_SWAP(0, 3);
+      CMP_SWAP(6, 9);
+      CMP_SWAP(2, 5);
+      CMP_SWAP(0, 1);
+      CMP_SWAP(3, 6);
+      CMP_SWAP(8, 9);
+      CMP_SWAP(4, 7);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 8);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(7, 9);
+
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(7, 8);
+
+      CMP_SWAP(1, 3);
+      CMP_SWAP(6, 8);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(5, 7);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(4, 5);
+      break;
+    case 9:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(7, 8);
+      CMP_SWAP(0, 1);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(6, 7);
+      CMP_SWAP(0, 3);
+      CMP_SWAP(3, 6);
+      CMP_SWAP(0, 3);
+      CMP_SWAP(1, 4);
+      CMP_SWAP(4, 7);
+      CMP_SWAP(1, 4);
+      CMP_SWAP(2, 5);
+      CMP_SWAP(5, 8);
+      CMP_SWAP(2, 5);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(5, 7);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(5, 6);
+      break;
+    case 8:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(6, 7);
+
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(5, 7);
+
+      CMP_SWAP(1, 2);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(1, 5);
+
+      CMP_SWAP(2, 6);
+      CMP_SWAP(3, 7);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(3, 5);
+
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      break;
+    case 7:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(4, 6);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(5, 6);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(2, 6);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      CMP_SWAP(5, 6);
+      break;
+    case 6:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(4, 5);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(1, 5);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(3, 5);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      break;
+    case 5:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(0, 4);
+      CMP_SWAP(2, 4);
+      CMP_SWAP(1, 2);
+      CMP_SWAP(3, 4);
+      break;
+    case 4:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(2, 3);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(1, 3);
+      CMP_SWAP(1, 2);
+      break;
+    case 3:
+      CMP_SWAP(0, 1);
+      CMP_SWAP(0, 2);
+      CMP_SWAP(1, 2);
+      break;
+    case 2:
+      CMP_SWAP(0, 1);
+      break;
+    default:
+      for (int i = 1; i < numMoves; i++)
+      {
+        tmp = mply[i];
+        int j = i;
+        for (; j && tmp.weight > mply[j - 1].weight ; --j)
+          mply[j] = mply[j - 1];
+        mply[j] = tmp;
+      }
+  }
+
+  return;
+}
+
+
+void MakeInputs(
+  vector<moveType>& moves,
+  vector<int>& lengths,
+  const int number)
+{
+  // Weights in the range the move generator produces, with
+  // plenty of ties. Lengths favour the short lists of following
+  // hands, as in a real search.
+  srand(17);
+  moves.resize(13 * static_cast<unsigned>(number));
+  lengths.resize(static_cast<unsigned>(number));
+
+  for (unsigned i = 0; i < lengths.size(); i++)
+  {
+    const int len = (rand() % 3 == 0 ? 2 + rand() % 12 : 2 + rand() % 5);
+    lengths[i] = len;
+
+    moveType * mp = &moves[13 * i];
+    for (int k = 0; k < len; k++)
+    {
+      mp[k].suit = rand() % DDS_SUITS;
+      mp[k].rank = 2 + k;
+      mp[k].sequence = 0;
+      mp[k].weight = 5 * (rand() % 12) - 20;
+    }
+  }
+}
+
+
+bool SameOrder(
+  const moveType * mp1,
+  const moveType * mp2,
+  const int len)
+{
+  for (int k = 0; k < len; k++)
+  {
+    if (mp1[k].suit != mp2[k].suit ||
+        mp1[k].rank != mp2[k].rank ||
+        mp1[k].weight != mp2[k].weight)
+      return false;
+  }
+  return true;
+}
+
+
+double TimeSort(
+  void (* sortFnc)(moveType [], const int),
+  const vector<moveType>& moves,
+  const vector<int>& lengths)
+{
+  moveType work[13];
+
+  const auto t0 = Clock::now();
+  for (unsigned i = 0; i < lengths.size(); i++)
+  {
+    const moveType * mp = &moves[13 * i];
+    for (int k = 0; k < lengths[i]; k++)
+      work[k] = mp[k];
+    (* sortFnc)(work, lengths[i]);
+  }
+  const auto t1 = Clock::now();
+
+  const std::chrono::duration<double, std::nano> d = t1 - t0;
+  return d.count() / lengths.size();
+}
+
+
+int main(int argc, char * argv[])
+{
+  const int number = (argc > 1 ? atoi(argv[1]) : 1000000);
+  if (number <= 0)
+  {
+    cout << "Usage: sortbench [number of sorts]\n";
+    return 1;
+  }
+
+  vector<moveType> moves;
+  vector<int> lengths;
+  MakeInputs(moves, lengths, number);
+
+  moveType ref[13], ours[13];
+  for (unsigned i = 0; i < lengths.size(); i++)
+  {
+    const moveType * mp = &moves[13 * i];
+    const int len = lengths[i];
+    for (int k = 0; k < len; k++)
+      ref[k] = ours[k] = mp[k];
+
+    ReferenceSort(ref, len);
+    SortMoves(ours, len);
+
+    if (! SameOrder(ref, ours, len))
+    {
+      cout << "Sort " << i << " of length " << len <<
+        " differs from the reference\n";
+      return 1;
+    }
+  }
+
+  const double tref = TimeSort(ReferenceSort, moves, lengths);
+  const double tours = TimeSort(SortMoves, moves, lengths);
+
+  cout << number << " sorts agree with the reference\n";
+  cout << setw(20) << left << "Reference (ns/sort)" <<
+    setw(8) << right << fixed << setprecision(1) << tref << "\n";
+  cout << setw(20) << left << "SortMoves (ns/sort)" <<
+    setw(8) << right << fixed << setprecision(1) << tours << "\n";
+  return 0;
+}
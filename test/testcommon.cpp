@@ -79,6 +79,18 @@ int realMain(const std::string& fname, Solver solver)
     stepsize = 1;
   else if (solver == DTEST_SOLVER_DEALERPAR)
     stepsize = 1;
+  else if (solver == DTEST_SOLVER_TRACE)
+    stepsize = MAXNOOFBOARDS;
+  else if (solver == DTEST_SOLVER_SESSION)
+    stepsize = MAXNOOFBOARDS;
+  else if (solver == DTEST_SOLVER_SPECULATE)
+    stepsize = MAXNOOFBOARDS;
+  else if (solver == DTEST_SOLVER_LINE)
+    stepsize = MAXNOOFBOARDS;
+  else if (solver == DTEST_SOLVER_BATCHPAR)
+    stepsize = 1;
+  else if (solver == DTEST_SOLVER_PBN)
+    stepsize = 1;
 
   main_identify(out);
 
@@ -136,6 +148,27 @@ int realMain(const std::string& fname, Solver solver)
     loop_dealerpar(out, dealer_list, vul_list, table_list, dealerpar_list,
         number, stepsize);
     break;
+  case DTEST_SOLVER_TRACE:
+    loop_trace(out, deal_list, play_list, trace_list, number, stepsize);
+    break;
+  case DTEST_SOLVER_SESSION:
+    loop_session(out, deal_list, play_list, trace_list, number, stepsize,
+        0);
+    break;
+  case DTEST_SOLVER_SPECULATE:
+    loop_session(out, deal_list, play_list, trace_list, number, stepsize,
+        4);
+    break;
+  case DTEST_SOLVER_LINE:
+    loop_line(out, deal_list, number, stepsize);
+    break;
+  case DTEST_SOLVER_BATCHPAR:
+    loop_batchpar(out, dealer_list, vul_list, table_list, par_list,
+        dealerpar_list, number);
+    break;
+  case DTEST_SOLVER_PBN:
+    loop_pbn(out, deal_list, number);
+    break;
   default:
     out << "Unknown type " <<
       static_cast<unsigned>(solver) << "\n";